@@ -1,10 +1,26 @@
 #pragma once
 #include "osal_types.h"
 
+/* Profile khởi động real-time (Linux), áp dụng một lần trong OSAL_Init khi enable = 1:
+ *  - mlockall(MCL_CURRENT | MCL_FUTURE): không trang nào của process bị swap / fault lại sau này
+ *  - tắt trim heap + malloc mmap → bộ nhớ heap đã fault không bị trả lại kernel
+ *  - prefault heap_reserve bytes heap và main_stack bytes stack của thread gọi OSAL_Init
+ *  - task có stack_size = 0 lấy task_stack từ stack provider (đã prefault, có guard) thay vì
+ *    stack mặc định 8 MB của pthread (bị mlockall khoá toàn bộ)
+ *  - cảnh báo nếu RT throttling (sched_rt_runtime_us != -1) đang bật
+ * Bước nào thất bại (vd: thiếu CAP_IPC_LOCK / RLIMIT_MEMLOCK) chỉ log, OSAL_Init vẫn OSAL_OK. */
+typedef struct {
+    uint8_t      enable;
+    size_t       heap_reserve;  // bytes (0 = không prefault heap)
+    size_t       main_stack;    // bytes (0 = OSAL_RT_MAIN_STACK_DEFAULT)
+    size_t       task_stack;    // bytes (0 = OSAL_RT_TASK_STACK_DEFAULT)
+} OSAL_RtProfile;
+
 typedef struct {
     OSAL_Backend backend;
     OSAL_LogFn   log;           // ví dụ: xil_printf
     void*        platform_ctx;  // ví dụ: con trỏ GIC
+    OSAL_RtProfile rt;
 } OSAL_Config;
 
 typedef struct {
@@ -0,0 +1,69 @@
+#pragma once
+#include "osal_types.h"
+#include "osal_task.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Cyclic executive (time-triggered): bảng lịch tĩnh các hàm chu kỳ chạy trên MỘT OSAL task RT.
+ *  - minor frame = ước chung lớn nhất của mọi period/offset (hoặc attr.minor_us), major frame =
+ *    bội chung nhỏ nhất của các period. Danh sách hàm của từng minor frame được tính sẵn lúc Create.
+ *  - Mỗi minor frame: ngủ đến mốc tuyệt đối (CLOCK_MONOTONIC, ns), chạy lần lượt các hàm đến hạn
+ *    theo thứ tự trong bảng. Mốc frame bám lưới đồng hồ → các executive cùng minor trên các core
+ *    khác nhau chạy cùng pha.
+ *  - Frame overrun: frame chạy quá biên minor → đếm, gọi on_overrun, bỏ qua các frame đã lỡ (giữ pha,
+ *    không chạy dồn) như OSAL_TaskDelayUntil.
+ *  - Hàm trong bảng không được block (Delay, mutex, I/O...): chúng chạy nối tiếp trên cùng thread.
+ *  - Một executive = một thread; muốn nhiều core thì tạo một executive cho mỗi core (cpu_mask).
+ */
+
+typedef struct OSAL_Cyclic* OSAL_CyclicHandle;
+
+typedef struct {
+    const char*     name;
+    OSAL_TaskEntry  fn;
+    void*           arg;
+    uint32_t        period_us;   // > 0
+    uint32_t        offset_us;   // pha trong chu kỳ, < period_us
+} OSAL_CyclicEntry;
+
+/* frame: index minor frame trong major frame, exec_us: thời gian frame đã chạy */
+typedef void (*OSAL_CyclicOverrunFn)(uint32_t frame, uint32_t exec_us, void* arg);
+
+typedef struct {
+    const char*          name;         // tên thread (NULL → "cyclic")
+    uint32_t             minor_us;     // 0 → tự tính; != 0 phải chia hết mọi period/offset
+    uint8_t              prio;         // như OSAL_TaskAttr.prio
+    uint32_t             stack_size;   // như OSAL_TaskAttr.stack_size
+    uint32_t             cpu_mask;     // như OSAL_TaskAttr.cpu_mask
+    OSAL_CyclicOverrunFn on_overrun;   // có thể NULL
+    void*                overrun_arg;
+} OSAL_CyclicAttr;
+
+typedef struct {
+    uint32_t    minor_us;
+    uint32_t    frames_per_major;
+    uint64_t    frames;            // minor frame đã chạy
+    uint64_t    majors;            // major frame đã hoàn tất
+    uint32_t    overruns;          // frame vượt biên minor
+    uint32_t    skipped;           // frame bị bỏ qua vì overrun
+    uint32_t    worst_exec_us;     // thời gian chạy frame lớn nhất
+    uint32_t    worst_jitter_us;   // trễ thức dậy lớn nhất so với mốc frame
+} OSAL_CyclicStats;
+
+/* table được chép lại; executive bắt đầu ở biên minor frame kế tiếp.
+ * OSAL_EINVAL: bảng sai / minor_us không chia hết / major frame quá OSAL_CYCLIC_MAX_FRAMES minor.
+ * OSAL_ENOMEM: hết bộ nhớ. */
+OSAL_Status OSAL_CyclicCreate(OSAL_CyclicHandle* c, const OSAL_CyclicEntry* table, uint32_t n,
+                              const OSAL_CyclicAttr* attr);
+/* Dừng ở biên frame kế tiếp (không cắt ngang hàm đang chạy) */
+OSAL_Status OSAL_CyclicDestroy(OSAL_CyclicHandle c);
+/* entry_worst_us (có thể NULL): n phần tử, thời gian chạy lớn nhất của từng hàm trong bảng */
+OSAL_Status OSAL_CyclicGetStats(OSAL_CyclicHandle c, OSAL_CyclicStats* st, uint32_t* entry_worst_us);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+#include "osal_types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Nhóm cờ sự kiện 32 bit (kiểu OSFlagPost/OSFlagPend của uC/OS, xEventGroup của FreeRTOS).
+ *  - Wait chờ bất kỳ (ANY) hoặc tất cả (ALL) các bit trong mask; CONSUME xóa các bit đã thỏa khi trả về.
+ *  - Đánh thức có chọn lọc: Set chỉ đánh thức người chờ mà điều kiện đã thỏa (mỗi người chờ có futex
+ *    riêng), không broadcast cả nhóm. Người chờ được xét theo thứ tự FIFO; CONSUME của người trước
+ *    ảnh hưởng điều kiện của người sau trong cùng một lần Set.
+ *  - Task fiber chờ bằng park/wake của scheduler fiber, không block carrier.
+ *  - Set/Clear dùng mutex nội bộ → không gọi được từ signal handler (dùng OSAL_SemGiveFromSignal).
+ */
+
+typedef struct OSAL_EventFlags* OSAL_EventFlagsHandle;
+
+#define OSAL_EVENT_WAIT_ANY     0u
+#define OSAL_EVENT_WAIT_ALL     (1u << 0)
+#define OSAL_EVENT_CONSUME      (1u << 1)   // xóa các bit trong mask đã thỏa khi Wait thành công
+
+typedef struct {
+    const char* name;
+    uint32_t    initial;    // giá trị cờ ban đầu
+} OSAL_EventFlagsAttr;
+
+OSAL_Status OSAL_EventFlagsCreate(OSAL_EventFlagsHandle* e, const OSAL_EventFlagsAttr* attr);
+/* OSAL_EBUSY nếu còn người đang chờ */
+OSAL_Status OSAL_EventFlagsDelete(OSAL_EventFlagsHandle e);
+OSAL_Status OSAL_EventFlagsSet(OSAL_EventFlagsHandle e, uint32_t bits);
+OSAL_Status OSAL_EventFlagsClear(OSAL_EventFlagsHandle e, uint32_t bits);
+/* options: OSAL_EVENT_WAIT_ANY/ALL | OSAL_EVENT_CONSUME. timeout_ms: 0 = không chờ,
+ * OSAL_WAIT_FOREVER = vô hạn; hết hạn → OSAL_ETIMEOUT.
+ * out (có thể NULL): giá trị cờ tại thời điểm điều kiện thỏa (trước khi CONSUME) */
+OSAL_Status OSAL_EventFlagsWait(OSAL_EventFlagsHandle e, uint32_t mask, uint32_t options,
+                                uint32_t timeout_ms, uint32_t* out);
+OSAL_Status OSAL_EventFlagsGet(OSAL_EventFlagsHandle e, uint32_t* bits);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+#include "osal_types.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Executor work-stealing cho job song song dữ liệu (fork/join).
+ *  - Mỗi worker (OSAL task, prio/affinity theo attr) có deque Chase-Lev riêng: chủ deque push/pop
+ *    ở đáy không khoá, worker rảnh steal ở đỉnh → không có hàng đợi chung bị khoá trên đường nóng.
+ *  - Range [begin, end) được chia đôi lười: worker giữ nửa trái, đẩy nửa phải vào deque của mình;
+ *    dừng chia khi range <= grain.
+ *  - ParallelFor/Reduce chặn đến khi xong. Gọi từ bên trong một job của cùng executor được phép
+ *    (worker gọi sẽ tham gia chạy job thay vì ngủ), trừ từ callback reduce (OSAL_EINVAL): worker có
+ *    thể nhận chunk khác của cùng Reduce và cộng vào accumulator đang dùng dở.
+ */
+
+typedef struct OSAL_Executor* OSAL_ExecHandle;
+
+typedef struct {
+    const char* name;         // tên thread worker (NULL → "exec")
+    uint32_t    workers;      // 0 → số CPU online (trong cpu_mask nếu có), tối đa OSAL_EXEC_MAX_WORKERS
+    uint8_t     prio;         // như OSAL_TaskAttr.prio
+    uint32_t    stack_size;   // như OSAL_TaskAttr.stack_size
+    uint32_t    cpu_mask;     // CPU được dùng (0 = mọi CPU online)
+    uint8_t     pin;          // 1: worker i ghim lên CPU thứ i (vòng lại) trong cpu_mask
+} OSAL_ExecAttr;
+
+typedef void (*OSAL_ExecRangeFn)(uint32_t begin, uint32_t end, void* arg);
+/* Cộng dồn [begin, end) vào acc (accumulator riêng của worker, khởi tạo = identity) */
+typedef void (*OSAL_ExecReduceFn)(uint32_t begin, uint32_t end, void* acc, void* arg);
+/* acc = acc ⊕ partial. Thứ tự gộp không xác định → phép gộp phải kết hợp + giao hoán. */
+typedef void (*OSAL_ExecCombineFn)(void* acc, const void* partial, void* arg);
+
+OSAL_Status OSAL_ExecCreate(OSAL_ExecHandle* e, const OSAL_ExecAttr* attr);
+/* Không Destroy khi còn ParallelFor/Reduce đang chạy */
+OSAL_Status OSAL_ExecDestroy(OSAL_ExecHandle e);
+uint32_t    OSAL_ExecWorkerCount(OSAL_ExecHandle e);
+
+/* grain = 0 → tự chọn (~8 phần mỗi worker) */
+OSAL_Status OSAL_ExecParallelFor(OSAL_ExecHandle e, uint32_t begin, uint32_t end, uint32_t grain,
+                                 OSAL_ExecRangeFn fn, void* arg);
+/* *result = identity ⊕ (partial của từng worker). identity, result: vùng size bytes. */
+OSAL_Status OSAL_ExecParallelReduce(OSAL_ExecHandle e, uint32_t begin, uint32_t end, uint32_t grain,
+                                    OSAL_ExecReduceFn fn, OSAL_ExecCombineFn combine, void* arg,
+                                    const void* identity, void* result, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
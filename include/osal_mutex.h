@@ -0,0 +1,47 @@
+#pragma once
+#include "osal_types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Mutex có kế thừa ưu tiên (priority inheritance).
+ *  - Không tranh chấp: Lock/Unlock chỉ là một CAS trên futex word trong user-space (không syscall).
+ *  - Tranh chấp: chờ trong kernel bằng futex PI (rt_mutex) → chủ mutex đang chạy SCHED_FIFO/RR
+ *    thấp hơn được đẩy lên bằng prio của task cao nhất đang chờ cho đến khi Unlock.
+ *    Task SCHED_OTHER (band nice) không được kế thừa nice, chỉ xếp hàng theo kernel.
+ *  - Chỉ chủ mutex được Unlock (OSAL_EINVAL nếu không phải). Lock lại khi đang giữ: mutex đệ quy
+ *    tăng đếm, mutex thường trả OSAL_EINVAL (thay vì tự deadlock).
+ *  - Task fiber: chủ là fiber (không phải carrier); khi tranh chấp fiber nhường carrier (yield) và
+ *    thử lại thay vì block carrier. Thread chờ mutex do fiber giữ vẫn đẩy prio carrier của fiber đó.
+ *  - Suspend chủ mutex: task OSAL_TASK_F_PREEMPT_SUSPEND chỉ đỗ sau Unlock mutex cuối cùng → người chờ
+ *    không treo. Suspend hợp tác đỗ task ở Delay/Yield kế tiếp: task Delay/Yield khi đang giữ mutex sẽ
+ *    đỗ cùng mutex và người chờ treo đến Resume (PI không đẩy được task đã đỗ) → không Delay/Yield
+ *    trong vùng giữ mutex nếu task có thể bị Suspend.
+ */
+
+typedef struct OSAL_Mutex* OSAL_MutexHandle;
+
+#define OSAL_MUTEX_F_RECURSIVE (1u << 0)
+
+typedef struct {
+    const char* name;
+    uint32_t    flags;      // OSAL_MUTEX_F_*
+} OSAL_MutexAttr;
+
+/* attr = NULL → mutex thường (không đệ quy) */
+OSAL_Status OSAL_MutexCreate(OSAL_MutexHandle* m, const OSAL_MutexAttr* attr);
+/* OSAL_EBUSY nếu đang bị giữ */
+OSAL_Status OSAL_MutexDelete(OSAL_MutexHandle m);
+OSAL_Status OSAL_MutexLock(OSAL_MutexHandle m);
+/* OSAL_EBUSY nếu đang bị task khác giữ */
+OSAL_Status OSAL_MutexTryLock(OSAL_MutexHandle m);
+/* timeout_ms: 0 = như TryLock (nhưng trả OSAL_ETIMEOUT), OSAL_WAIT_FOREVER = như Lock */
+OSAL_Status OSAL_MutexLockTimeout(OSAL_MutexHandle m, uint32_t timeout_ms);
+OSAL_Status OSAL_MutexUnlock(OSAL_MutexHandle m);
+
+#ifdef __cplusplus
+}
+#endif
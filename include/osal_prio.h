@@ -0,0 +1,55 @@
+#pragma once
+#include "osal_types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Priority domain: ánh xạ prio của firmware (theo quy ước của OSAL_Backend) sang Linux.
+ *
+ *  prio (backend) ──chuẩn hoá──► rank (0 = cao nhất .. 255 = thấp nhất) ──band──► policy + giá trị Linux
+ *
+ *  - uC/OS-III, Linux : rank = prio                       (0 = cao nhất)
+ *  - FreeRTOS         : rank = OSAL_FREERTOS_MAX_PRIO-1-prio (số lớn = cao hơn)
+ *
+ * Mỗi backend có 2 bảng band (cấu hình lúc compile, đổi được lúc runtime):
+ *  - rt : dùng khi có CAP_SYS_NICE (SCHED_FIFO / SCHED_RR / nice)
+ *  - fb : fallback khi không có quyền → chỉ nice, vẫn giữ thứ tự tương đối giữa các task
+ * Trong một band giá trị được nội suy tuyến tính từ first (tại rank_lo) đến last (tại rank_hi),
+ * nên thứ tự prio luôn được giữ (chỉ có thể trùng mức khi band bị nén).
+ */
+
+typedef enum {
+    OSAL_PRIO_POLICY_OTHER = 0,   // SCHED_OTHER, value = nice (-20..19)
+    OSAL_PRIO_POLICY_FIFO,        // SCHED_FIFO,  value = sched_priority (1..99)
+    OSAL_PRIO_POLICY_RR,          // SCHED_RR,    value = sched_priority (1..99)
+} OSAL_PrioPolicy;
+
+typedef struct {
+    uint8_t         rank_lo;      // rank đầu band (ưu tiên cao hơn)
+    uint8_t         rank_hi;      // rank cuối band
+    OSAL_PrioPolicy policy;
+    int8_t          first;        // giá trị Linux tại rank_lo
+    int8_t          last;         // giá trị Linux tại rank_hi
+} OSAL_PrioBand;
+
+typedef struct {
+    OSAL_PrioPolicy policy;
+    int             value;        // sched_priority hoặc nice
+} OSAL_PrioMapping;
+
+/* Thay bảng band của một backend. Các band phải nối tiếp nhau, phủ đủ rank 0..255,
+ * và không được đảo thứ tự (rank cao hơn → không "khẩn" hơn rank thấp hơn). */
+OSAL_Status OSAL_PrioSetBands(OSAL_Backend backend,
+                              const OSAL_PrioBand* rt, uint32_t n_rt,
+                              const OSAL_PrioBand* fb, uint32_t n_fb);
+
+/* Tính mapping cho prio theo backend hiện tại (g_osal.cfg.backend).
+ * privileged = 0 → dùng bảng fallback. */
+OSAL_Status OSAL_PrioResolve(uint8_t prio, uint8_t privileged, OSAL_PrioMapping* out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+#include "osal_types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Hàng đợi message MPMC có giới hạn (kiểu xQueueSend/xQueueReceive, OSQPost/OSQPend).
+ *  - Item kích thước cố định, chép theo giá trị vào vòng đệm cấp một lần lúc Create.
+ *  - Vòng đệm lock-free (mỗi ô một số thứ tự): Send/Receive không tranh chấp không khóa, không syscall.
+ *    Chỉ khi một phía phải ngủ (đầy / rỗng) mới vào futex, và phía kia chỉ gọi futex_wake khi có người ngủ.
+ *  - length là luỹ thừa 2 thì chỉ số dùng mask; ngược lại dùng phép chia (chậm hơn một chút).
+ *  - Gửi lên đầu (SendToFront): item đi vào vòng ưu tiên riêng (front_length ô) mà Receive luôn lấy
+ *    trước → Receive kế tiếp nhận nó. Các item gửi lên đầu giữ thứ tự FIFO giữa chúng.
+ *  - Task fiber chờ bằng nhường carrier rồi thử lại, không block carrier.
+ */
+
+typedef struct OSAL_Queue* OSAL_QueueHandle;
+
+typedef struct {
+    const char* name;
+    uint32_t    length;         // số item tối đa (> 0)
+    uint32_t    item_size;      // byte mỗi item (> 0)
+    uint32_t    front_length;   // sức chứa vòng SendToFront; 0 → không hỗ trợ SendToFront (OSAL_EINVAL)
+} OSAL_QueueAttr;
+
+OSAL_Status OSAL_QueueCreate(OSAL_QueueHandle* q, const OSAL_QueueAttr* attr);
+/* OSAL_EBUSY nếu còn người đang chờ */
+OSAL_Status OSAL_QueueDelete(OSAL_QueueHandle q);
+
+/* timeout_ms: 0 = không chờ, OSAL_WAIT_FOREVER = vô hạn; đầy / rỗng đến hết hạn → OSAL_ETIMEOUT */
+OSAL_Status OSAL_QueueSend(OSAL_QueueHandle q, const void* item, uint32_t timeout_ms);
+OSAL_Status OSAL_QueueSendToFront(OSAL_QueueHandle q, const void* item, uint32_t timeout_ms);
+OSAL_Status OSAL_QueueReceive(OSAL_QueueHandle q, void* item, uint32_t timeout_ms);
+
+/* Không chờ: đầy / rỗng → OSAL_EBUSY */
+OSAL_Status OSAL_QueueTrySend(OSAL_QueueHandle q, const void* item);
+OSAL_Status OSAL_QueueTrySendToFront(OSAL_QueueHandle q, const void* item);
+OSAL_Status OSAL_QueueTryReceive(OSAL_QueueHandle q, void* item);
+
+/* Số item hiện có (xấp xỉ khi đang có Send/Receive đồng thời) */
+OSAL_Status OSAL_QueueGetCount(OSAL_QueueHandle q, uint32_t* count);
+
+#ifdef __cplusplus
+}
+#endif
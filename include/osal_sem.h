@@ -0,0 +1,39 @@
+#pragma once
+#include "osal_types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Semaphore đếm (kiểu OSSemPost/OSSemPend, xSemaphoreGive/Take).
+ *  - Give/Take không tranh chấp: một atomic op, không syscall. Chỉ khi Take phải chờ mới vào futex,
+ *    và Give chỉ gọi futex_wake khi có người đang chờ.
+ *  - OSAL_SemGiveFromSignal: an toàn trong signal handler (chỉ atomic + futex_wake), tương đương
+ *    GiveFromISR của các backend RTOS.
+ *  - Take từ task fiber không block carrier: fiber nhường carrier rồi thử lại.
+ *  - Take không phải điểm dừng của task: Delete task đang chờ vô hạn sẽ chờ đến lần Give kế tiếp.
+ */
+
+typedef struct OSAL_Sem* OSAL_SemHandle;
+
+typedef struct {
+    const char* name;
+    uint32_t    initial;    // giá trị đầu (<= max)
+    uint32_t    max;        // 0 → INT32_MAX; 1 → semaphore nhị phân
+} OSAL_SemAttr;
+
+OSAL_Status OSAL_SemCreate(OSAL_SemHandle* s, const OSAL_SemAttr* attr);
+/* OSAL_EBUSY nếu còn người đang chờ */
+OSAL_Status OSAL_SemDelete(OSAL_SemHandle s);
+/* OSAL_EBUSY nếu đã đạt max (giá trị không đổi) */
+OSAL_Status OSAL_SemGive(OSAL_SemHandle s);
+OSAL_Status OSAL_SemGiveFromSignal(OSAL_SemHandle s);
+/* timeout_ms: 0 = không chờ, OSAL_WAIT_FOREVER = chờ vô hạn; hết hạn → OSAL_ETIMEOUT */
+OSAL_Status OSAL_SemTake(OSAL_SemHandle s, uint32_t timeout_ms);
+OSAL_Status OSAL_SemGetCount(OSAL_SemHandle s, uint32_t* count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+#include "osal_types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Kênh vòng SPSC: đúng MỘT task ghi và MỘT task đọc (vd. sampler → filter). Không kiểm tra lúc chạy.
+ *  - Push/Pop wait-free: không CAS, không khóa, không syscall. Chỉ số ghi / đọc nằm trên cache line
+ *    riêng, mỗi phía giữ bản cache chỉ số phía kia → chỉ đọc line của phía kia khi bản cache hết chỗ / hết dữ liệu.
+ *  - Batch: Push/Pop chép tối đa n item một lần (tối đa hai memcpy), trả số item thực sự chép.
+ *  - Chờ (tùy chọn): WaitData / WaitSpace ngủ trên futex đến khi có ít nhất n item / n chỗ trống;
+ *    phía kia chỉ syscall khi có người chờ VÀ ngưỡng đã đạt (consumer chờ batch không bị đánh thức từng item).
+ *  - Task fiber chờ bằng nhường carrier rồi thử lại, không block carrier.
+ */
+
+typedef struct OSAL_Spsc* OSAL_SpscHandle;
+
+typedef struct {
+    const char* name;
+    uint32_t    length;     // số item tối đa (> 0)
+    uint32_t    item_size;  // byte mỗi item (> 0)
+} OSAL_SpscAttr;
+
+OSAL_Status OSAL_SpscCreate(OSAL_SpscHandle* ch, const OSAL_SpscAttr* attr);
+/* OSAL_EBUSY nếu có phía đang chờ */
+OSAL_Status OSAL_SpscDelete(OSAL_SpscHandle ch);
+
+/* Chỉ task ghi. Chép tối đa n item liên tiếp từ items; *pushed (có thể NULL) = số item đã chép */
+OSAL_Status OSAL_SpscPush(OSAL_SpscHandle ch, const void* items, uint32_t n, uint32_t* pushed);
+/* Chỉ task đọc. Lấy tối đa max item vào items; *popped (có thể NULL) = số item đã lấy */
+OSAL_Status OSAL_SpscPop(OSAL_SpscHandle ch, void* items, uint32_t max, uint32_t* popped);
+
+/* Chờ đến khi có ít nhất n item (task đọc) / n chỗ trống (task ghi); 1 <= n <= length.
+ * timeout_ms: 0 = không chờ, OSAL_WAIT_FOREVER = vô hạn; hết hạn → OSAL_ETIMEOUT */
+OSAL_Status OSAL_SpscWaitData(OSAL_SpscHandle ch, uint32_t n, uint32_t timeout_ms);
+OSAL_Status OSAL_SpscWaitSpace(OSAL_SpscHandle ch, uint32_t n, uint32_t timeout_ms);
+
+/* Số item hiện có (xấp xỉ khi phía kia đang chạy) */
+OSAL_Status OSAL_SpscGetCount(OSAL_SpscHandle ch, uint32_t* count);
+
+#ifdef __cplusplus
+}
+#endif
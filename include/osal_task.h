@@ -7,7 +7,10 @@ extern "C" {
 #endif
 
 typedef void (*OSAL_TaskEntry)(void* arg);
-typedef void* OSAL_TaskHandle;
+// opaque: (generation, index), 0 = không hợp lệ, handle cũ → OSAL_EINVAL.
+// 64 bit cả trên target 32 bit: generation đủ rộng để handle cũ không trùng task mới khi slot quay vòng nhanh
+typedef uint64_t OSAL_TaskHandle;
+typedef uint32_t OSAL_Tick;   // ms, CLOCK_MONOTONIC (wrap ~49 ngày)
 
 typedef enum {
     OSAL_TASK_STATE_INVALID = 0,
@@ -18,26 +21,167 @@ typedef enum {
     OSAL_TASK_STATE_COMPLETED,
 } OSAL_TaskState;
 
+/* Cờ cho OSAL_TaskAttr.flags */
+#define OSAL_TASK_F_ISOLATED_CPU   (1u << 0)  // tự đặt lên core isolcpus/nohz_full ít tải nhất (trong cpu_mask nếu có)
+#define OSAL_TASK_F_PREEMPT_SUSPEND (1u << 1) // Suspend đỗ task ngay bằng signal, không cần task gọi Delay/Yield.
+                                              // Task đang giữ OSAL_Mutex chỉ đỗ khi Unlock mutex cuối cùng.
+                                              // Không async-signal-safe với khoá khác: task bị đỗ ở bất kỳ lệnh
+                                              // nào, kể cả khi đang giữ khoá của libc (malloc, stdio...),
+                                              // pthread_mutex hay OSAL_Sem dùng làm khoá → mọi task chờ khoá
+                                              // đó treo đến khi Resume. Chỉ dùng cho task không giữ các khoá đó.
+#define OSAL_TASK_F_FIBER          (1u << 2)  // chạy như fiber trên carrier thread dùng chung (M:N), xem dưới
+
 typedef struct {
     const char* name;
-    uint16_t    stack_size;   // bytes
-    uint8_t     prio;         // 0 = cao nhất (theo RTOS)
+    uint32_t    stack_size;   // bytes (0 = mặc định của pthread); làm tròn lên trang, tối thiểu PTHREAD_STACK_MIN
+    uint8_t     prio;         // quy ước theo OSAL_Backend (uC/OS: 0 = cao nhất), xem osal_prio.h
+    uint32_t    cpu_mask;     // bit i = CPU i, 0 = không ràng buộc
+    uint32_t    flags;        // OSAL_TASK_F_*
+    /* SCHED_DEADLINE (EDF + budget do kernel cưỡng chế): dl_runtime_us != 0 thì bỏ qua prio.
+     * Yêu cầu runtime <= deadline <= period, deadline = 0 → bằng period, không dùng cùng cpu_mask.
+     * OSAL_TaskCreate trả OSAL_EBUSY nếu kernel từ chối (admission control: tổng băng thông vượt ngưỡng). */
+    uint32_t    dl_runtime_us;
+    uint32_t    dl_deadline_us;
+    uint32_t    dl_period_us;
 } OSAL_TaskAttr;
 
+/* Thống kê cho vòng lặp chu kỳ dùng OSAL_TaskDelayUntil */
+typedef struct {
+    uint32_t    periods;          // tổng số chu kỳ
+    uint32_t    missed;           // số chu kỳ lỡ deadline (kể cả chu kỳ bị bỏ qua)
+    uint32_t    worst_overrun_us; // trễ lớn nhất so với deadline (us)
+} OSAL_TaskPeriodStats;
+
+/* Thống kê runtime của task. Đọc lười từ kernel (CPU clock của thread, /proc/self/task/<tid>/...)
+ * nên để bật thường trực trong production cũng không tốn gì khi không gọi. */
+typedef struct {
+    OSAL_TaskHandle      handle;
+    char                 name[16];         // bản sao ("" nếu không tên): slot có thể bị tái dùng sau khi đọc
+    uint64_t             cpu_time_us;      // CPU time của thread
+    uint64_t             runq_wait_us;     // thời gian chờ trên runqueue (schedstat)
+    uint32_t             voluntary_csw;    // context switch tự nguyện (block/sleep)
+    uint32_t             involuntary_csw;  // bị preempt
+    uint32_t             delays;           // số lần Delay/DelayUntil thực sự ngủ
+    uint64_t             suspended_us;     // tổng thời gian bị suspend (đã đỗ)
+    int32_t              last_cpu;         // CPU chạy gần nhất (-1 nếu không rõ)
+    int32_t              policy;           // SCHED_* đang áp dụng
+    int32_t              sched_prio;       // sched_priority (FIFO/RR) hoặc nice (SCHED_OTHER)
+    OSAL_TaskPeriodStats period;
+} OSAL_TaskStats;
+
+/* Task fiber (OSAL_TASK_F_FIBER): stack nhỏ (mặc định OSAL_FIBER_STACK_DEFAULT, không áp PTHREAD_STACK_MIN),
+ * chuyển ngữ cảnh user-space tại OSAL_TaskDelayMs / DelayUntil / Yield / Suspend (chính nó).
+ * Chuyển ngữ cảnh bằng asm trên x86_64 / aarch64; kiến trúc khác (kể cả arm 32 bit, trừ khi build
+ * với -DOSAL_FIBER_ARM_ASM) dùng ucontext (thêm một syscall sigprocmask mỗi lần chuyển).
+ * prio chỉ quyết định thứ tự giữa các fiber cùng carrier (bitmap theo rank, xem osal_prio.h).
+ * Không dùng chung với PREEMPT_SUSPEND, ISOLATED_CPU, cpu_mask, SCHED_DEADLINE (OSAL_EINVAL);
+ * SetAffinity trả OSAL_EINVAL. Mọi lời gọi block khác (mutex, I/O, sleep của libc, work queue...)
+ * block cả carrier cùng các fiber trên nó. Fiber bị Delete giữa chừng bỏ stack, không unwind. */
 /* ===== Core API ===== */
+/* Task có entry trả về sẽ nhả thread vào cache (OSAL_THREAD_CACHE_MAX); OSAL_TaskCreate sau đó
+ * gắn task mới vào thread rảnh có stack phù hợp thay vì pthread_create. Task bị Delete giữa chừng
+ * (stop), hoặc thread không trả được về lập lịch mặc định (nice đã nâng, thiếu quyền hạ), thì thread
+ * thoát như cũ. */
 OSAL_Status OSAL_TaskCreate(OSAL_TaskHandle* h, OSAL_TaskEntry entry, void* arg, const OSAL_TaskAttr* attr);
+/* Delete chính task gọi (handle của mình) = Detach + OSAL_TaskExit(0): không trả về */
 OSAL_Status OSAL_TaskDelete(OSAL_TaskHandle h);
 OSAL_Status OSAL_TaskSuspend(OSAL_TaskHandle h);
 OSAL_Status OSAL_TaskResume(OSAL_TaskHandle h);
 OSAL_Status OSAL_TaskChangePrio(OSAL_TaskHandle h, uint8_t new_prio);
+OSAL_Status OSAL_TaskSetAffinity(OSAL_TaskHandle h, uint32_t cpu_mask);
 OSAL_Status OSAL_TaskGetState(OSAL_TaskHandle h, OSAL_TaskState* state);
 OSAL_Status OSAL_TaskGetName(OSAL_TaskHandle h, const char** name);
 void        OSAL_TaskDelayMs(uint32_t ms);
 void        OSAL_TaskYield(void);
 
-/* ===== Utility ===== */
+/* ===== Batch create =====
+ * Tạo n task (song song khi n lớn), mọi task đứng ở cổng trước entry; tạo xong hết mới thả cùng
+ * lúc tại mốc chung: bội số kế tiếp của align_ms trên lưới tick (align_ms = 0 → thả ngay).
+ * *start (có thể NULL) = tick của mốc thả → dùng làm last_wake cho DelayUntil để các task cùng pha.
+ * Một task tạo lỗi → các task đã tạo bị xoá trước khi chạy entry, trả về lỗi của task lỗi đầu tiên
+ * (theo thứ tự bảng), không handle nào được ghi. */
+typedef struct {
+    OSAL_TaskHandle*     handle;   // nhận handle (có thể NULL)
+    OSAL_TaskEntry       entry;
+    void*                arg;
+    const OSAL_TaskAttr* attr;     // như OSAL_TaskCreate (NULL = mặc định)
+} OSAL_TaskSpec;
+
+OSAL_Status OSAL_TaskCreateBatch(const OSAL_TaskSpec* spec, uint32_t n, uint32_t align_ms, OSAL_Tick* start);
+
+/* ===== Join / Detach =====
+ * Task kết thúc khi entry trả về (status 0) hoặc gọi OSAL_TaskExit(status) → trạng thái COMPLETED,
+ * slot + status được giữ đến khi Join (hoặc Delete). OSAL_TaskExit trên task thread thoát thread
+ * (không về cache); gọi từ thread ngoài OSAL thì không có tác dụng.
+ * Join: timeout_ms 0 = chỉ kiểm tra, OSAL_WAIT_FOREVER = chờ vô hạn; hết hạn → OSAL_ETIMEOUT, task
+ * vẫn chạy. Thành công → handle hết hiệu lực. Không Join chính mình / task đã Detach (OSAL_EINVAL).
+ * Detach: task tự dọn khi kết thúc (đã COMPLETED thì dọn ngay); sau đó không Join/Delete được nữa.
+ * WaitAny: chờ đến khi một trong n task COMPLETED, *index = vị trí của nó (chưa dọn, Join để lấy
+ * status). Handle không hợp lệ → OSAL_EINVAL, *index = vị trí handle đó. Chờ trên futex chung:
+ * không tốn gì khi không có ai gọi. Gọi từ task fiber (kể cả Delete): chờ bằng cách nhường carrier
+ * theo từng bước ngắn, fiber khác cùng carrier vẫn chạy được. */
+void        OSAL_TaskExit(int32_t status);
+OSAL_Status OSAL_TaskJoin(OSAL_TaskHandle h, uint32_t timeout_ms, int32_t* status);
+OSAL_Status OSAL_TaskDetach(OSAL_TaskHandle h);
+OSAL_Status OSAL_TaskWaitAny(const OSAL_TaskHandle* h, uint32_t n, uint32_t timeout_ms, uint32_t* index);
+
+/* ===== Periodic (kiểu vTaskDelayUntil) =====
+ * Ngủ đến *last_wake + period_ms rồi cập nhật *last_wake → chu kỳ không bị trôi.
+ * Khởi tạo: last_wake = OSAL_TaskGetTickCount().
+ * Nếu đã trễ deadline: không ngủ, bỏ qua các chu kỳ đã lỡ (giữ pha) và trả về OSAL_ETIMEOUT. */
+OSAL_Tick   OSAL_TaskGetTickCount(void);
+OSAL_Status OSAL_TaskDelayUntil(OSAL_Tick* last_wake, uint32_t period_ms);
+OSAL_Status OSAL_TaskGetPeriodStats(OSAL_TaskHandle h, OSAL_TaskPeriodStats* st);
+
+/* ===== Task notification (kiểu xTaskNotify / ulTaskNotifyTake) =====
+ * Mỗi task có một giá trị notify 32 bit + cờ "đang chờ nhận". Notify không khoá, không cấp phát:
+ * với task thread nó an toàn trong signal handler (async-signal-safe); với task fiber thì không.
+ * NotifyWait/NotifyTake chỉ gọi từ chính task (OSAL_EINVAL nếu không phải task OSAL),
+ * đồng thời là điểm kiểm tra suspend/stop như Delay. */
+typedef enum {
+    OSAL_NOTIFY_NONE = 0,       // chỉ đánh thức, giữ nguyên giá trị
+    OSAL_NOTIFY_SET_BITS,       // value |= bits
+    OSAL_NOTIFY_INCREMENT,      // value += 1 (tham số value bị bỏ qua) → dùng như semaphore đếm
+    OSAL_NOTIFY_OVERWRITE,      // value = v
+    OSAL_NOTIFY_NO_OVERWRITE,   // value = v nếu chưa có notify chờ nhận, ngược lại OSAL_EBUSY
+} OSAL_NotifyAction;
+
+OSAL_Status OSAL_TaskNotify(OSAL_TaskHandle h, uint32_t value, OSAL_NotifyAction action);
+/* Chờ notify: clear_on_entry xoá bit lúc vào (nếu chưa có notify chờ sẵn), clear_on_exit xoá bit
+ * sau khi đọc. *value (có thể NULL) = giá trị trước khi xoá. timeout_ms: 0 = không chờ,
+ * OSAL_WAIT_FOREVER = chờ vô hạn. Hết hạn → OSAL_ETIMEOUT. */
+OSAL_Status OSAL_TaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t* value, uint32_t timeout_ms);
+/* Chờ giá trị khác 0 rồi về 0 (clear != 0) hoặc trừ 1; *value = giá trị trước đó */
+OSAL_Status OSAL_TaskNotifyTake(uint8_t clear, uint32_t* value, uint32_t timeout_ms);
+
+/* ===== Task-local storage (kiểu OSTaskRegSet / vTaskSetThreadLocalStoragePointer) =====
+ * Mỗi task có OSAL_TASK_LOCAL_SLOTS con trỏ, khởi tạo NULL khi Create. h = 0 → task hiện tại:
+ * đọc/ghi thẳng qua TLS, không khoá (OSAL_EINVAL nếu không phải task OSAL). h khác → task đó
+ * (khoá slot task, handle cũ → OSAL_EINVAL). OSAL không giải phóng giá trị khi task kết thúc. */
+#ifndef OSAL_TASK_LOCAL_SLOTS
+#define OSAL_TASK_LOCAL_SLOTS 8
+#endif
+OSAL_Status OSAL_TaskSetLocal(OSAL_TaskHandle h, uint32_t slot, void* value);
+OSAL_Status OSAL_TaskGetLocal(OSAL_TaskHandle h, uint32_t slot, void** value);
+
+/* ===== Utility =====
+ * Count / ForEach / Snapshot không khoá, không chặn Create/Delete: chỉ thấy task đã Create xong
+ * và chưa bị dọn. Snapshot chép từng bản ghi dưới seqlock của slot → không bao giờ rách (slot đang
+ * bị ghi lâu thì chờ khoá của slot đó); các bản ghi là ảnh tại thời điểm đọc từng slot (không phải
+ * một thời điểm chung cho cả bảng). */
+typedef struct {
+    OSAL_TaskHandle handle;
+    char            name[16];
+    uint8_t         prio;       // prio yêu cầu gần nhất (attr / ChangePrio)
+    uint32_t        cpu_mask;   // affinity hiện tại (0 = mọi CPU)
+    uint32_t        flags;      // OSAL_TASK_F_* lúc tạo
+} OSAL_TaskInfo;
+
 uint32_t    OSAL_TaskCount(void);
 OSAL_Status OSAL_TaskForEach(void (*cb)(OSAL_TaskHandle h, void* arg), void* arg);
+OSAL_Status OSAL_TaskSnapshot(OSAL_TaskInfo* out, uint32_t max, uint32_t* count);
+OSAL_Status OSAL_TaskGetStats(OSAL_TaskHandle h, OSAL_TaskStats* st);
+OSAL_Status OSAL_TaskGetStatsAll(OSAL_TaskStats* out, uint32_t max, uint32_t* count);
 
 #ifdef __cplusplus
 }
@@ -8,8 +8,13 @@ typedef enum {
     OSAL_ETIMEOUT,
     OSAL_EOS,
     OSAL_EINIT,
+    OSAL_EBUSY,     // tài nguyên không đủ (vd: admission control của SCHED_DEADLINE từ chối)
+    OSAL_ENOMEM,    // cấp phát bộ nhớ thất bại
 } OSAL_Status;
 
+// Timeout (ms) cho các API chờ: chờ vô hạn
+#define OSAL_WAIT_FOREVER UINT32_MAX
+
 typedef enum {
     OSAL_BACKEND_UCOS3 = 1,
     OSAL_BACKEND_FREERTOS,
@@ -0,0 +1,61 @@
+#pragma once
+#include "osal_types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Work queue: pool cố định OSAL task (cùng prio / stack / affinity) chạy các callback ngắn theo FIFO.
+ *  - OSAL_Work do người gọi sở hữu → Submit không cấp phát; item phải sống đến khi callback bắt đầu
+ *    chạy hoặc bị Cancel. Trạng thái "đang chờ" được xoá trước khi gọi callback, nên callback được
+ *    phép Submit lại hoặc giải phóng chính item của nó.
+ *  - Callback chạy trong task worker: có thể OSAL_TaskDelayMs, nhưng càng ngắn càng tốt
+ *    (block lâu chiếm worker của các job khác).
+ */
+
+typedef void (*OSAL_WorkFn)(void* arg);
+
+typedef struct OSAL_Work {
+    OSAL_WorkFn       fn;
+    void*             arg;
+    /* nội bộ – khởi tạo bằng OSAL_WorkInit / OSAL_WORK_INIT */
+    struct OSAL_Work* next;
+    uint64_t          seq;
+    uint8_t           pending;
+} OSAL_Work;
+
+#define OSAL_WORK_INIT(f, a) { (f), (a), NULL, 0, 0 }
+
+typedef struct OSAL_WorkQueue* OSAL_WorkQueueHandle;
+
+typedef struct {
+    const char* name;         // tên thread worker (NULL → "workq")
+    uint32_t    workers;      // số worker (0 → 1), tối đa OSAL_WORKQ_MAX_WORKERS
+    uint8_t     prio;         // như OSAL_TaskAttr.prio
+    uint32_t    stack_size;   // như OSAL_TaskAttr.stack_size
+    uint32_t    cpu_mask;     // như OSAL_TaskAttr.cpu_mask
+} OSAL_WorkQueueAttr;
+
+void        OSAL_WorkInit(OSAL_Work* w, OSAL_WorkFn fn, void* arg);
+
+OSAL_Status OSAL_WorkQueueCreate(OSAL_WorkQueueHandle* q, const OSAL_WorkQueueAttr* attr);
+/* Chạy hết job đang chờ rồi dừng worker; trả về sau khi mọi callback (kể cả đang Delay) đã xong.
+ * Không Submit song song với Destroy. */
+OSAL_Status OSAL_WorkQueueDestroy(OSAL_WorkQueueHandle q);
+
+/* OSAL_EBUSY nếu w đang chờ trong một queue */
+OSAL_Status OSAL_WorkSubmit(OSAL_WorkQueueHandle q, OSAL_Work* w);
+/* Submit n item với một lần lấy khoá; *submitted (có thể NULL) = số item đã vào hàng đợi.
+ * Item đang chờ sẵn bị bỏ qua và kết quả là OSAL_EBUSY. */
+OSAL_Status OSAL_WorkSubmitBatch(OSAL_WorkQueueHandle q, OSAL_Work* const* w, uint32_t n, uint32_t* submitted);
+/* Gỡ w khỏi hàng đợi nếu chưa chạy. OSAL_EINVAL nếu w không còn chờ (đã/đang chạy hoặc chưa Submit). */
+OSAL_Status OSAL_WorkCancel(OSAL_WorkQueueHandle q, OSAL_Work* w);
+/* Chờ mọi job đã Submit trước lời gọi này chạy xong (job Submit sau không tính).
+ * Không gọi từ callback của chính queue đó (OSAL_EINVAL). */
+OSAL_Status OSAL_WorkFlush(OSAL_WorkQueueHandle q, uint32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,28 +3,30 @@
 #include "board_led.h"
 #include <stdint.h>
 
-OSAL_TaskHandle hBlink = NULL;
-OSAL_TaskHandle hLog   = NULL;
+OSAL_TaskHandle hBlink = 0;
+OSAL_TaskHandle hLog   = 0;
 
 static void BlinkTask(void* arg) {
     (void)arg;
     uint8_t state = 0;
     BoardLed_Init();
+    OSAL_Tick last = OSAL_TaskGetTickCount();
     for (;;) {
         state ^= 1u;
         BoardLed_Set(state);
         OSAL_LOG("[Blink] LED=%s\r\n", state ? "ON" : "OFF");
-        OSAL_TaskDelayMs(500);
+        OSAL_TaskDelayUntil(&last, 500);
     }
 }
 
 static void LogTask(void* arg) {
     (void)arg;
     uint32_t ms = 0;
+    OSAL_Tick last = OSAL_TaskGetTickCount();
     for (;;) {
         ms += 2000;
         OSAL_LOG("[Log] uptime=%u ms\r\n", (unsigned)ms);
-        OSAL_TaskDelayMs(2000);
+        OSAL_TaskDelayUntil(&last, 2000);
     }
 }
 
@@ -42,18 +44,24 @@ static void CtrlTask(void* arg) {
 }
 
 void Demo1_Start(void) {
-    OSAL_Status s1,s2,s3;
-    OSAL_TaskHandle hCtrl = NULL;
+    OSAL_Status s;
+    OSAL_TaskHandle hCtrl = 0;
 
     // uC/OS-III: Blink < Log < Ctrl
     OSAL_TaskAttr a1 = { .name="BlinkTask", .stack_size=2048, .prio=15 };
     OSAL_TaskAttr a2 = { .name="LogTask",   .stack_size=2048, .prio=20 };
     OSAL_TaskAttr a3 = { .name="CtrlTask",  .stack_size=2048, .prio=25 };
 
-    s1 = OSAL_TaskCreate(&hBlink, BlinkTask, NULL, &a1);
-    s2 = OSAL_TaskCreate(&hLog,   LogTask,   NULL, &a2);
-    s3 = OSAL_TaskCreate(&hCtrl,  CtrlTask,  NULL, &a3);
+    // Tạo cả 3 rồi thả cùng lúc trên mốc 100 ms → thứ tự khởi động chỉ còn phụ thuộc prio
+    const OSAL_TaskSpec specs[] = {
+        { &hBlink, BlinkTask, NULL, &a1 },
+        { &hLog,   LogTask,   NULL, &a2 },
+        { &hCtrl,  CtrlTask,  NULL, &a3 },
+    };
+    OSAL_Tick start = 0;
+    s = OSAL_TaskCreateBatch(specs, sizeof(specs) / sizeof(specs[0]), 100, &start);
 
-    OSAL_LOG("[Demo1] Create Blink=%d, Log=%d, Ctrl=%d (handles: %p %p %p)\r\n",
-             s1, s2, s3, (void*)hBlink, (void*)hLog, (void*)hCtrl);
+    OSAL_LOG("[Demo1] Create batch=%d start=%u (handles: %llx %llx %llx)\r\n",
+             s, (unsigned)start, (unsigned long long)hBlink, (unsigned long long)hLog,
+             (unsigned long long)hCtrl);
 }
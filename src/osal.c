@@ -1,6 +1,10 @@
 #include "osal.h"
 #include <string.h>
 
+#if defined(__linux__)
+#include "osal_linux_priv.h"
+#endif
+
 OSAL_Global g_osal = {0};
 
 OSAL_Status OSAL_Init(const OSAL_Config *cfg) {
@@ -9,6 +13,9 @@ OSAL_Status OSAL_Init(const OSAL_Config *cfg) {
     g_osal.cfg = *cfg;
     g_osal.initialized = 1;
     OSAL_LOG("[OSAL] Init backend=%d\r\n", (int)cfg->backend);
+#if defined(__linux__)
+    if (cfg->rt.enable) osal_rt_apply();
+#endif
     return OSAL_OK;
 }
 
@@ -0,0 +1,225 @@
+// OSAL cyclic executive cho Linux
+// - Một OSAL task RT chạy vòng frame: clock_nanosleep(TIMER_ABSTIME) đến mốc frame → chạy danh sách hàm
+// - Lịch (hàm nào chạy ở minor frame nào) tính một lần lúc Create → vòng lặp không tìm kiếm, không cấp phát
+// - Thống kê cập nhật một lần mỗi frame dưới mutex (không tranh chấp trừ khi có người đọc)
+
+#include "osal_cyclic.h"
+#include "osal_task.h"
+#include "osal.h"
+#include "osal_linux_priv.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <errno.h>
+
+// Số minor frame tối đa trong một major frame (bảng lịch tính sẵn)
+#ifndef OSAL_CYCLIC_MAX_FRAMES
+#define OSAL_CYCLIC_MAX_FRAMES 4096u
+#endif
+
+#ifndef OSAL_CYCLIC_MAX_ENTRIES
+#define OSAL_CYCLIC_MAX_ENTRIES 256u
+#endif
+
+struct OSAL_Cyclic {
+    OSAL_CyclicEntry* entries;
+    uint32_t          n;
+    uint64_t          minor_ns;
+    uint32_t          nframes;
+    uint32_t*         frame_first;   // [nframes + 1]: đầu danh sách của frame k trong frame_list
+    uint32_t*         frame_list;    // index vào entries
+    OSAL_CyclicAttr   attr;
+    OSAL_TaskHandle   task;
+    _Atomic int       stop;
+    pthread_mutex_t   mtx;           // bảo vệ stats + entry_worst
+    OSAL_CyclicStats  stats;
+    uint32_t*         entry_worst;   // [n]
+    uint32_t*         frame_us;      // [n]: thời gian chạy trong frame vừa xong (chỉ task ghi), gộp vào entry_worst
+};
+
+static uint64_t gcd_u64(uint64_t a, uint64_t b)
+{
+    while (b) {
+        uint64_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+static void cyclic_main(void* arg)
+{
+    struct OSAL_Cyclic* c = (struct OSAL_Cyclic*)arg;
+    uint64_t minor = c->minor_ns;
+    uint32_t* ran = c->frame_us;
+
+    // Mốc đầu: biên minor thứ hai kể từ bây giờ (chừa thời gian khởi động), frame index theo lưới đồng hồ
+    uint64_t rel   = (mono_ns() / minor + 2u) * minor;
+    uint32_t frame = (uint32_t)((rel / minor) % c->nframes);
+
+    while (!atomic_load(&c->stop)) {
+        struct timespec ts = { (time_t)(rel / 1000000000ull), (long)(rel % 1000000000ull) };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) { }
+        if (atomic_load(&c->stop)) break;
+
+        uint64_t start = mono_ns();
+        uint64_t t = start;
+        for (uint32_t i = c->frame_first[frame]; i < c->frame_first[frame + 1]; ++i) {
+            const OSAL_CyclicEntry* e = &c->entries[c->frame_list[i]];
+            e->fn(e->arg);
+            uint64_t now = mono_ns();
+            ran[c->frame_list[i]] = (uint32_t)((now - t) / 1000u);   // ghi đè: chỉ giá trị của frame này
+            t = now;
+        }
+
+        // Số minor tiến tới: 1 nếu kịp, nhiều hơn nếu overrun (bỏ các frame đã lỡ, giữ pha)
+        uint64_t adv = 1;
+        if (t > rel + minor) adv = (t - rel + minor - 1u) / minor;
+        uint32_t exec_us   = (uint32_t)((t - rel) / 1000u);
+        uint32_t jitter_us = (uint32_t)((start - rel) / 1000u);
+        uint64_t wraps     = (frame + adv) / c->nframes;
+
+        pthread_mutex_lock(&c->mtx);
+        c->stats.frames++;
+        c->stats.majors += wraps;
+        if (exec_us > c->stats.worst_exec_us)     c->stats.worst_exec_us   = exec_us;
+        if (jitter_us > c->stats.worst_jitter_us) c->stats.worst_jitter_us = jitter_us;
+        if (adv > 1) {
+            c->stats.overruns++;
+            c->stats.skipped += (uint32_t)(adv - 1u);
+        }
+        for (uint32_t i = c->frame_first[frame]; i < c->frame_first[frame + 1]; ++i) {
+            uint32_t k = c->frame_list[i];
+            if (ran[k] > c->entry_worst[k]) c->entry_worst[k] = ran[k];
+        }
+        pthread_mutex_unlock(&c->mtx);
+
+        if (adv > 1 && c->attr.on_overrun) c->attr.on_overrun(frame, exec_us, c->attr.overrun_arg);
+
+        frame = (uint32_t)((frame + adv) % c->nframes);
+        rel  += adv * minor;
+    }
+}
+
+// Tính minor/major và danh sách hàm của từng minor frame
+static OSAL_Status cyclic_build(struct OSAL_Cyclic* c, uint32_t minor_us)
+{
+    uint64_t g = minor_us;
+    uint64_t major = 1;
+    for (uint32_t i = 0; i < c->n; ++i) {
+        const OSAL_CyclicEntry* e = &c->entries[i];
+        if (!e->fn || !e->period_us || e->offset_us >= e->period_us) return OSAL_EINVAL;
+        if (!minor_us) {
+            g = gcd_u64(g, e->period_us);
+            if (e->offset_us) g = gcd_u64(g, e->offset_us);
+        } else if (e->period_us % minor_us || e->offset_us % minor_us) {
+            return OSAL_EINVAL;
+        }
+        // lcm; major luôn <= MAX_FRAMES * minor <= MAX_FRAMES * UINT32_MAX nên chặn trước khi nhân
+        uint64_t q = major / gcd_u64(major, e->period_us);
+        if (q > (uint64_t)OSAL_CYCLIC_MAX_FRAMES * UINT32_MAX / e->period_us) return OSAL_EINVAL;
+        major = q * e->period_us;
+    }
+    if (!g || major / g > OSAL_CYCLIC_MAX_FRAMES) return OSAL_EINVAL;
+
+    c->minor_ns = g * 1000u;
+    c->nframes  = (uint32_t)(major / g);
+
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < c->n; ++i) total += (uint32_t)(major / c->entries[i].period_us);
+
+    c->frame_first = (uint32_t*)calloc(c->nframes + 1u, sizeof(uint32_t));
+    c->frame_list  = (uint32_t*)calloc(total ? total : 1u, sizeof(uint32_t));
+    if (!c->frame_first || !c->frame_list) return OSAL_ENOMEM;
+
+    uint32_t k = 0;
+    for (uint32_t f = 0; f < c->nframes; ++f) {
+        c->frame_first[f] = k;
+        uint64_t t_us = (uint64_t)f * g;
+        for (uint32_t i = 0; i < c->n; ++i) {
+            const OSAL_CyclicEntry* e = &c->entries[i];
+            if (t_us >= e->offset_us && (t_us - e->offset_us) % e->period_us == 0) c->frame_list[k++] = i;
+        }
+    }
+    c->frame_first[c->nframes] = k;
+    return OSAL_OK;
+}
+
+static void cyclic_free(struct OSAL_Cyclic* c)
+{
+    pthread_mutex_destroy(&c->mtx);
+    free(c->frame_us);
+    free(c->entry_worst);
+    free(c->frame_list);
+    free(c->frame_first);
+    free(c->entries);
+    free(c);
+}
+
+OSAL_Status OSAL_CyclicCreate(OSAL_CyclicHandle* out, const OSAL_CyclicEntry* table, uint32_t n,
+                              const OSAL_CyclicAttr* attr)
+{
+    if (!out || !table || !n || n > OSAL_CYCLIC_MAX_ENTRIES || !attr) return OSAL_EINVAL;
+
+    struct OSAL_Cyclic* c = (struct OSAL_Cyclic*)calloc(1, sizeof(*c));
+    if (!c) return OSAL_ENOMEM;
+    pthread_mutex_init(&c->mtx, NULL);
+    c->n    = n;
+    c->attr = *attr;
+    c->entries     = (OSAL_CyclicEntry*)malloc(n * sizeof(*table));
+    c->entry_worst = (uint32_t*)calloc(n, sizeof(uint32_t));
+    c->frame_us    = (uint32_t*)calloc(n, sizeof(uint32_t));   // cấp ở đây: task không có đường báo lỗi
+    if (!c->entries || !c->entry_worst || !c->frame_us) {
+        cyclic_free(c);
+        return OSAL_ENOMEM;
+    }
+    memcpy(c->entries, table, n * sizeof(*table));
+
+    OSAL_Status st = cyclic_build(c, attr->minor_us);
+    if (st != OSAL_OK) {
+        cyclic_free(c);
+        return st;
+    }
+    c->stats.minor_us         = (uint32_t)(c->minor_ns / 1000u);
+    c->stats.frames_per_major = c->nframes;
+
+    OSAL_TaskAttr ta;
+    memset(&ta, 0, sizeof(ta));
+    ta.name       = attr->name ? attr->name : "cyclic";
+    ta.prio       = attr->prio;
+    ta.stack_size = attr->stack_size;
+    ta.cpu_mask   = attr->cpu_mask;
+    st = OSAL_TaskCreate(&c->task, cyclic_main, c, &ta);
+    if (st != OSAL_OK) {
+        OSAL_LOG("[OSAL][Cyclic] %s: create task failed (%d)\r\n", ta.name, (int)st);
+        cyclic_free(c);
+        return st;
+    }
+    OSAL_LOG("[OSAL][Cyclic] %s: minor=%u us, %u frames/major, %u entries\r\n",
+             ta.name, (unsigned)c->stats.minor_us, (unsigned)c->nframes, (unsigned)n);
+    *out = c;
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_CyclicDestroy(OSAL_CyclicHandle c)
+{
+    if (!c) return OSAL_EINVAL;
+    // Vòng lặp thấy stop ở biên frame → entry trả về, OSAL_TaskDelete chỉ còn dọn
+    atomic_store(&c->stop, 1);
+    OSAL_TaskDelete(c->task);
+    cyclic_free(c);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_CyclicGetStats(OSAL_CyclicHandle c, OSAL_CyclicStats* st, uint32_t* entry_worst_us)
+{
+    if (!c || !st) return OSAL_EINVAL;
+    pthread_mutex_lock(&c->mtx);
+    *st = c->stats;
+    if (entry_worst_us) memcpy(entry_worst_us, c->entry_worst, c->n * sizeof(uint32_t));
+    pthread_mutex_unlock(&c->mtx);
+    return OSAL_OK;
+}
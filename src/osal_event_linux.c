@@ -0,0 +1,183 @@
+// OSAL event flags cho Linux
+// - Cờ + danh sách người chờ dưới một mutex; người chờ nằm trên stack của chính nó (không cấp phát)
+// - Set xét từng người chờ theo FIFO: thỏa → gỡ khỏi danh sách, ghi kết quả, đánh thức đúng người đó
+//   (futex riêng của thread, osal_fiber_wake cho fiber). Người chưa thỏa không bị đánh thức.
+// - Set đánh thức ngay trong mutex, người chờ luôn thoát qua mutex → Set không còn chạm waiter
+//   sau khi nó trả về (waiter trên stack)
+
+#include "osal_event.h"
+#include "osal.h"
+#include "osal_linux_priv.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#ifndef OSAL_EVENT_NAME_MAX
+#define OSAL_EVENT_NAME_MAX 16
+#endif
+
+typedef struct EventWaiter {
+    struct EventWaiter* next;
+    uint32_t            mask;
+    uint32_t            options;
+    uint32_t            result;     // cờ lúc thỏa (Set ghi trong mutex)
+    OsalFiber*          fiber;      // NULL → thread, chờ trên ready
+    _Atomic int         ready;      // futex
+} EventWaiter;
+
+struct OSAL_EventFlags {
+    pthread_mutex_t mtx;
+    uint32_t        flags;
+    EventWaiter*    head;           // FIFO
+    EventWaiter*    tail;
+    uint32_t        nwait;
+    char            name[OSAL_EVENT_NAME_MAX];
+};
+
+static inline int event_match(uint32_t flags, uint32_t mask, uint32_t options)
+{
+    return (options & OSAL_EVENT_WAIT_ALL) ? ((flags & mask) == mask) : ((flags & mask) != 0);
+}
+
+static void event_unlink_locked(struct OSAL_EventFlags* e, EventWaiter* w)
+{
+    EventWaiter** pp = &e->head;
+    EventWaiter*  prev = NULL;
+    while (*pp && *pp != w) {
+        prev = *pp;
+        pp = &(*pp)->next;
+    }
+    if (!*pp) return;
+    *pp = w->next;
+    if (e->tail == w) e->tail = prev;
+    e->nwait--;
+}
+
+OSAL_Status OSAL_EventFlagsCreate(OSAL_EventFlagsHandle* out, const OSAL_EventFlagsAttr* attr)
+{
+    if (!out) return OSAL_EINVAL;
+    struct OSAL_EventFlags* e = (struct OSAL_EventFlags*)calloc(1, sizeof(*e));
+    if (!e) return OSAL_ENOMEM;
+    pthread_mutex_init(&e->mtx, NULL);
+    if (attr) {
+        e->flags = attr->initial;
+        if (attr->name) strncpy(e->name, attr->name, sizeof(e->name) - 1);
+    }
+    *out = e;
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_EventFlagsDelete(OSAL_EventFlagsHandle e)
+{
+    if (!e) return OSAL_EINVAL;
+    pthread_mutex_lock(&e->mtx);
+    uint32_t n = e->nwait;
+    pthread_mutex_unlock(&e->mtx);
+    if (n) return OSAL_EBUSY;
+    pthread_mutex_destroy(&e->mtx);
+    free(e);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_EventFlagsSet(OSAL_EventFlagsHandle e, uint32_t bits)
+{
+    if (!e) return OSAL_EINVAL;
+    pthread_mutex_lock(&e->mtx);
+    e->flags |= bits;
+    EventWaiter* prev = NULL;
+    EventWaiter* w = e->head;
+    while (w) {
+        EventWaiter* next = w->next;
+        if (event_match(e->flags, w->mask, w->options)) {
+            if (prev) prev->next = next;
+            else      e->head = next;
+            if (e->tail == w) e->tail = prev;
+            e->nwait--;
+            w->result = e->flags;
+            if (w->options & OSAL_EVENT_CONSUME) e->flags &= ~w->mask;
+            atomic_store_explicit(&w->ready, 1, memory_order_release);
+            if (w->fiber) osal_fiber_wake(w->fiber);
+            else          futex_wake(&w->ready, 1);
+        } else {
+            prev = w;
+        }
+        w = next;
+    }
+    pthread_mutex_unlock(&e->mtx);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_EventFlagsClear(OSAL_EventFlagsHandle e, uint32_t bits)
+{
+    if (!e) return OSAL_EINVAL;
+    pthread_mutex_lock(&e->mtx);
+    e->flags &= ~bits;
+    pthread_mutex_unlock(&e->mtx);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_EventFlagsWait(OSAL_EventFlagsHandle e, uint32_t mask, uint32_t options,
+                                uint32_t timeout_ms, uint32_t* out)
+{
+    if (!e || !mask) return OSAL_EINVAL;
+
+    pthread_mutex_lock(&e->mtx);
+    if (event_match(e->flags, mask, options)) {
+        if (out) *out = e->flags;
+        if (options & OSAL_EVENT_CONSUME) e->flags &= ~mask;
+        pthread_mutex_unlock(&e->mtx);
+        return OSAL_OK;
+    }
+    if (timeout_ms == 0) {
+        pthread_mutex_unlock(&e->mtx);
+        return OSAL_ETIMEOUT;
+    }
+
+    EventWaiter w;
+    memset(&w, 0, sizeof(w));
+    w.mask    = mask;
+    w.options = options;
+    w.fiber   = osal_fiber_self();
+    if (e->tail) e->tail->next = &w;
+    else         e->head = &w;
+    e->tail = &w;
+    e->nwait++;
+    pthread_mutex_unlock(&e->mtx);
+
+    uint64_t deadline = (timeout_ms == OSAL_WAIT_FOREVER) ? 0 : mono_ns() + (uint64_t)timeout_ms * 1000000ull;
+    if (w.fiber) {
+        while (!atomic_load_explicit(&w.ready, memory_order_acquire)) {
+            if (!deadline) osal_fiber_park();
+            else if (osal_fiber_sleep_until(deadline)) break;
+        }
+    } else {
+        struct timespec dl = { (time_t)(deadline / 1000000000ull), (long)(deadline % 1000000000ull) };
+        while (!atomic_load_explicit(&w.ready, memory_order_acquire)) {
+            if (futex_wait_abs(&w.ready, 0, deadline ? &dl : NULL) != 0 && errno == ETIMEDOUT) break;
+        }
+    }
+
+    // Luôn thoát qua mutex: Set có thể vừa thỏa điều kiện đúng lúc hết hạn
+    OSAL_Status st = OSAL_OK;
+    pthread_mutex_lock(&e->mtx);
+    if (atomic_load_explicit(&w.ready, memory_order_relaxed)) {
+        if (out) *out = w.result;
+    } else {
+        event_unlink_locked(e, &w);
+        st = OSAL_ETIMEOUT;
+    }
+    pthread_mutex_unlock(&e->mtx);
+    return st;
+}
+
+OSAL_Status OSAL_EventFlagsGet(OSAL_EventFlagsHandle e, uint32_t* bits)
+{
+    if (!e || !bits) return OSAL_EINVAL;
+    pthread_mutex_lock(&e->mtx);
+    *bits = e->flags;
+    pthread_mutex_unlock(&e->mtx);
+    return OSAL_OK;
+}
@@ -0,0 +1,523 @@
+// OSAL work-stealing executor cho Linux
+// - Worker = OSAL task; mỗi worker có deque Chase-Lev (mảng vòng cố định, C11 atomics)
+// - Job gốc từ thread ngoài đi qua injection queue (mutex, chỉ chạm một lần mỗi lời gọi)
+// - Job con cấp từ free-list riêng của worker → không malloc / không tranh chấp trên đường nóng
+// - Worker rảnh: thử steal vài vòng rồi ngủ trên futex sự kiện (chỉ đánh thức khi có worker ngủ)
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE     // cpu_set_t, sched_getaffinity
+#endif
+
+#include "osal_exec.h"
+#include "osal_task.h"
+#include "osal.h"
+#include "osal_linux_priv.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <errno.h>
+
+#ifndef OSAL_EXEC_MAX_WORKERS
+#define OSAL_EXEC_MAX_WORKERS 32
+#endif
+
+// Dung lượng deque mỗi worker (luỹ thừa 2). Chia đôi lười → độ sâu ~log2(range/grain), đầy thì chạy tại chỗ
+#ifndef OSAL_EXEC_DEQUE_CAP
+#define OSAL_EXEC_DEQUE_CAP 256u
+#endif
+
+// Số vòng thử steal trước khi ngủ
+#ifndef OSAL_EXEC_SPIN
+#define OSAL_EXEC_SPIN 64
+#endif
+
+// Worker chờ lồng hết việc để giúp: ngủ trên root tối đa chừng này (us) rồi quét lại
+#ifndef OSAL_EXEC_NEST_NAP_US
+#define OSAL_EXEC_NEST_NAP_US 200
+#endif
+
+#define OSAL_EXEC_CACHELINE 64
+
+_Static_assert((OSAL_EXEC_DEQUE_CAP & (OSAL_EXEC_DEQUE_CAP - 1)) == 0, "OSAL_EXEC_DEQUE_CAP phải là luỹ thừa 2");
+
+struct ExecRoot;
+
+typedef struct ExecJob {
+    struct ExecRoot* root;
+    uint32_t         begin;
+    uint32_t         end;
+    struct ExecJob*  next;       // free-list / injection queue
+    uint8_t          embedded;   // job gốc nằm trong ExecRoot → không trả về free-list
+} ExecJob;
+
+// Một lời gọi ParallelFor/Reduce (nằm trên stack của người gọi)
+typedef struct ExecRoot {
+    OSAL_ExecRangeFn   fn;
+    OSAL_ExecReduceFn  reduce;
+    void*              arg;
+    uint32_t           grain;
+    const void*        identity;
+    size_t             size;
+    size_t             stride;       // khoảng cách giữa 2 partial (làm tròn cache line)
+    char*              partials;     // [nworkers] accumulator riêng
+    uint8_t*           touched;      // worker i đã khởi tạo partial chưa (chỉ worker i ghi)
+    _Atomic uint64_t   remaining;    // số phần tử chưa chạy xong
+    _Atomic int        done;         // futex: 1 khi remaining về 0
+    ExecJob            job;
+} ExecRoot;
+
+typedef struct {
+    _Alignas(OSAL_EXEC_CACHELINE) _Atomic int64_t top;     // thief
+    _Alignas(OSAL_EXEC_CACHELINE) _Atomic int64_t bottom;  // chủ deque
+    _Atomic(ExecJob*) buf[OSAL_EXEC_DEQUE_CAP];
+} ExecDeque;
+
+typedef struct {
+    ExecDeque              dq;
+    struct OSAL_Executor*  ex;
+    uint32_t               id;
+    uint32_t               rng;        // chọn nạn nhân steal
+    ExecJob*               free_jobs;  // chỉ worker này chạm vào
+    uint32_t               in_reduce;  // > 0: đang trong callback reduce (acc của worker đang dùng dở)
+    OSAL_TaskHandle        task;
+} ExecWorker;
+
+struct OSAL_Executor {
+    pthread_mutex_t   inj_mtx;
+    ExecJob*          inj_head;        // injection queue (FIFO)
+    ExecJob*          inj_tail;
+    _Atomic int       inj_count;
+    _Alignas(OSAL_EXEC_CACHELINE) _Atomic int work_seq;   // futex sự kiện "có việc mới"
+    _Atomic int       sleepers;
+    _Atomic int       stop;
+    uint32_t          nworkers;
+    ExecWorker*       workers;         // mảng căn cache line
+};
+
+// Worker hiện tại (NULL nếu không phải worker của executor nào)
+static __thread ExecWorker* tls_worker = NULL;
+
+// ===== Chase-Lev deque (Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models") =====
+
+static int deque_push(ExecDeque* d, ExecJob* j)
+{
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (b - t >= (int64_t)OSAL_EXEC_DEQUE_CAP) return 0;
+    atomic_store_explicit(&d->buf[b & (OSAL_EXEC_DEQUE_CAP - 1)], j, memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_release);
+    return 1;
+}
+
+static ExecJob* deque_take(ExecDeque* d)
+{
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+    ExecJob* j = atomic_load_explicit(&d->buf[b & (OSAL_EXEC_DEQUE_CAP - 1)], memory_order_relaxed);
+    if (t == b) {
+        // Phần tử cuối: tranh với thief
+        if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed)) {
+            j = NULL;
+        }
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return j;
+}
+
+static ExecJob* deque_steal(ExecDeque* d)
+{
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) return NULL;
+    ExecJob* j = atomic_load_explicit(&d->buf[t & (OSAL_EXEC_DEQUE_CAP - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        return NULL;   // thua thief khác / chủ deque
+    }
+    return j;
+}
+
+// ===== Job pool theo worker =====
+
+static ExecJob* job_alloc(ExecWorker* w)
+{
+    ExecJob* j = w->free_jobs;
+    if (j) {
+        w->free_jobs = j->next;
+        return j;
+    }
+    return (ExecJob*)malloc(sizeof(ExecJob));
+}
+
+static void job_free(ExecWorker* w, ExecJob* j)
+{
+    if (j->embedded) return;
+    j->next = w->free_jobs;
+    w->free_jobs = j;
+}
+
+// ===== Đánh thức / tìm việc =====
+
+static void exec_notify(struct OSAL_Executor* ex, int n)
+{
+    // Cặp với sleepers++ (seq_cst) rồi kiểm tra lại hàng đợi phía worker → không mất wakeup
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&ex->sleepers, memory_order_relaxed) > 0) {
+        atomic_fetch_add(&ex->work_seq, 1);
+        futex_wake(&ex->work_seq, n);
+    }
+}
+
+static ExecJob* inject_pop(struct OSAL_Executor* ex)
+{
+    if (atomic_load_explicit(&ex->inj_count, memory_order_relaxed) == 0) return NULL;
+    pthread_mutex_lock(&ex->inj_mtx);
+    ExecJob* j = ex->inj_head;
+    if (j) {
+        ex->inj_head = j->next;
+        if (!ex->inj_head) ex->inj_tail = NULL;
+        atomic_fetch_sub(&ex->inj_count, 1);
+    }
+    pthread_mutex_unlock(&ex->inj_mtx);
+    return j;
+}
+
+static ExecJob* exec_find_work(ExecWorker* w)
+{
+    struct OSAL_Executor* ex = w->ex;
+    ExecJob* j = deque_take(&w->dq);
+    if (j) return j;
+    j = inject_pop(ex);
+    if (j) return j;
+
+    // Steal bắt đầu từ nạn nhân ngẫu nhiên (xorshift)
+    uint32_t n = ex->nworkers;
+    w->rng ^= w->rng << 13;
+    w->rng ^= w->rng >> 17;
+    w->rng ^= w->rng << 5;
+    uint32_t start = w->rng % n;
+    for (uint32_t i = 0; i < n; ++i) {
+        ExecWorker* v = &ex->workers[(start + i) % n];
+        if (v == w) continue;
+        j = deque_steal(&v->dq);
+        if (j) return j;
+    }
+    return NULL;
+}
+
+static int exec_has_work(const struct OSAL_Executor* ex)
+{
+    if (atomic_load(&ex->inj_count) > 0) return 1;
+    for (uint32_t i = 0; i < ex->nworkers; ++i) {
+        const ExecDeque* d = &ex->workers[i].dq;
+        if (atomic_load(&d->bottom) > atomic_load(&d->top)) return 1;
+    }
+    return 0;
+}
+
+// Chạy một job: chia đôi đến grain (nửa phải vào deque), chạy phần còn lại, báo hoàn tất
+static void exec_run(ExecWorker* w, ExecJob* j)
+{
+    ExecRoot* r = j->root;
+    uint32_t  b = j->begin;
+    uint32_t  e = j->end;
+    job_free(w, j);
+
+    while (e - b > r->grain) {
+        uint32_t mid = b + (e - b) / 2;
+        ExecJob* s = job_alloc(w);
+        if (!s) break;
+        s->root     = r;
+        s->begin    = mid;
+        s->end      = e;
+        s->embedded = 0;
+        if (!deque_push(&w->dq, s)) {
+            job_free(w, s);
+            break;
+        }
+        exec_notify(w->ex, 1);
+        e = mid;
+    }
+
+    if (r->reduce) {
+        void* acc = r->partials + (size_t)w->id * r->stride;
+        if (!r->touched[w->id]) {
+            memcpy(acc, r->identity, r->size);
+            r->touched[w->id] = 1;
+        }
+        w->in_reduce++;
+        r->reduce(b, e, acc, r->arg);
+        w->in_reduce--;
+    } else {
+        r->fn(b, e, r->arg);
+    }
+
+    uint64_t n = (uint64_t)(e - b);
+    if (atomic_fetch_sub_explicit(&r->remaining, n, memory_order_acq_rel) == n) {
+        // Người gọi có thể rời hàm ngay sau khi thấy done → không chạm r sau lệnh wake
+        atomic_store_explicit(&r->done, 1, memory_order_release);
+        futex_wake(&r->done, INT_MAX);
+    }
+}
+
+static void exec_worker(void* arg)
+{
+    ExecWorker* w = (ExecWorker*)arg;
+    struct OSAL_Executor* ex = w->ex;
+    tls_worker = w;
+
+    for (;;) {
+        ExecJob* j = NULL;
+        for (int spin = 0; spin < OSAL_EXEC_SPIN && !j; ++spin) {
+            j = exec_find_work(w);
+        }
+        if (j) {
+            exec_run(w, j);
+            continue;
+        }
+
+        int seq = atomic_load(&ex->work_seq);
+        atomic_fetch_add(&ex->sleepers, 1);
+        if (!exec_has_work(ex) && !atomic_load(&ex->stop)) {
+            futex_wait(&ex->work_seq, seq, NULL);
+        }
+        atomic_fetch_sub(&ex->sleepers, 1);
+        if (atomic_load(&ex->stop) && !exec_has_work(ex)) break;
+    }
+
+    while (w->free_jobs) {
+        ExecJob* j = w->free_jobs;
+        w->free_jobs = j->next;
+        free(j);
+    }
+    tls_worker = NULL;
+}
+
+// Chọn CPU thứ i (vòng lại) trong tập cho phép
+static int exec_nth_cpu(const cpu_set_t* set, uint32_t i)
+{
+    int cnt = CPU_COUNT(set);
+    if (cnt <= 0) return -1;
+    uint32_t k = i % (uint32_t)cnt;
+    for (int c = 0; c < CPU_SETSIZE; ++c) {
+        if (CPU_ISSET(c, set) && k-- == 0) return c;
+    }
+    return -1;
+}
+
+OSAL_Status OSAL_ExecCreate(OSAL_ExecHandle* out, const OSAL_ExecAttr* attr)
+{
+    if (!out || !attr) return OSAL_EINVAL;
+
+    // CPU khả dụng = affinity của process ∩ cpu_mask
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        for (long c = 0; c < n && c < CPU_SETSIZE; ++c) CPU_SET(c, &set);
+    }
+    if (attr->cpu_mask) {
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (c >= 32 || !(attr->cpu_mask & (1u << c))) CPU_CLR(c, &set);
+        }
+        if (CPU_COUNT(&set) == 0) return OSAL_EINVAL;
+    }
+
+    uint32_t n = attr->workers ? attr->workers : (uint32_t)CPU_COUNT(&set);
+    if (n == 0) n = 1;
+    if (n > OSAL_EXEC_MAX_WORKERS) {
+        if (attr->workers) return OSAL_EINVAL;
+        n = OSAL_EXEC_MAX_WORKERS;
+    }
+
+    struct OSAL_Executor* ex = (struct OSAL_Executor*)aligned_alloc(OSAL_EXEC_CACHELINE, sizeof(*ex));
+    if (!ex) return OSAL_ENOMEM;
+    memset(ex, 0, sizeof(*ex));
+    size_t wbytes = (sizeof(ExecWorker) * n + OSAL_EXEC_CACHELINE - 1) / OSAL_EXEC_CACHELINE * OSAL_EXEC_CACHELINE;
+    ex->workers = (ExecWorker*)aligned_alloc(OSAL_EXEC_CACHELINE, wbytes);
+    if (!ex->workers) {
+        free(ex);
+        return OSAL_ENOMEM;
+    }
+    memset(ex->workers, 0, wbytes);
+    pthread_mutex_init(&ex->inj_mtx, NULL);
+    ex->nworkers = n;
+
+    OSAL_TaskAttr ta;
+    memset(&ta, 0, sizeof(ta));
+    ta.name       = attr->name ? attr->name : "exec";
+    ta.prio       = attr->prio;
+    ta.stack_size = attr->stack_size;
+
+    // nworkers cố định trước khi worker đầu tiên chạy (steal duyệt toàn mảng); worker chưa tạo có deque rỗng
+    OSAL_Status st = OSAL_OK;
+    uint32_t created = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        ExecWorker* w = &ex->workers[i];
+        w->ex  = ex;
+        w->id  = i;
+        w->rng = 0x9E3779B9u * (i + 1);
+        ta.cpu_mask = attr->cpu_mask;
+        if (attr->pin) {
+            int c = exec_nth_cpu(&set, i);
+            if (c >= 0 && c < 32) ta.cpu_mask = 1u << c;
+        }
+        st = OSAL_TaskCreate(&w->task, exec_worker, w, &ta);
+        if (st != OSAL_OK) break;
+        created++;
+    }
+    if (st != OSAL_OK) {
+        OSAL_LOG("[OSAL][Exec] %s: create worker %u failed (%d)\r\n", ta.name, (unsigned)created, (int)st);
+        ex->nworkers = created;
+        OSAL_ExecDestroy(ex);
+        return st;
+    }
+
+    *out = ex;
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_ExecDestroy(OSAL_ExecHandle ex)
+{
+    if (!ex || (tls_worker && tls_worker->ex == ex)) return OSAL_EINVAL;
+
+    atomic_store(&ex->stop, 1);
+    atomic_fetch_add(&ex->work_seq, 1);
+    futex_wake(&ex->work_seq, INT_MAX);
+    for (uint32_t i = 0; i < ex->nworkers; ++i) {
+        OSAL_TaskDelete(ex->workers[i].task);
+    }
+
+    pthread_mutex_destroy(&ex->inj_mtx);
+    free(ex->workers);
+    free(ex);
+    return OSAL_OK;
+}
+
+uint32_t OSAL_ExecWorkerCount(OSAL_ExecHandle ex)
+{
+    return ex ? ex->nworkers : 0;
+}
+
+// Callback reduce đang chạy trên worker của ex gọi lồng vào ex? Worker tham gia sẽ có thể lấy chunk khác
+// của cùng root và reduce vào đúng acc đang dùng dở → từ chối
+static inline int exec_in_reduce(const struct OSAL_Executor* ex)
+{
+    return tls_worker && tls_worker->ex == ex && tls_worker->in_reduce;
+}
+
+// Chạy root đến khi xong: worker của chính executor thì tham gia, thread ngoài thì inject + ngủ
+static void exec_submit_wait(struct OSAL_Executor* ex, ExecRoot* r)
+{
+    ExecWorker* self = (tls_worker && tls_worker->ex == ex) ? tls_worker : NULL;
+
+    if (self) {
+        exec_run(self, &r->job);
+        int misses = 0;
+        while (!atomic_load_explicit(&r->done, memory_order_acquire)) {
+            ExecJob* j = exec_find_work(self);
+            if (j) {
+                exec_run(self, j);
+                misses = 0;
+                continue;
+            }
+            if (++misses < OSAL_EXEC_SPIN) continue;
+            // Phần còn lại của r đang chạy trên worker khác → ngủ (không sched_yield vô hạn: worker RT
+            // chung CPU sẽ bỏ đói chính worker đang giữ việc); hết nap thì quét lại việc mới
+            const struct timespec nap = { 0, OSAL_EXEC_NEST_NAP_US * 1000L };
+            futex_wait(&r->done, 0, &nap);
+            misses = 0;
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&ex->inj_mtx);
+    r->job.next = NULL;
+    if (ex->inj_tail) ex->inj_tail->next = &r->job;
+    else              ex->inj_head = &r->job;
+    ex->inj_tail = &r->job;
+    atomic_fetch_add(&ex->inj_count, 1);
+    pthread_mutex_unlock(&ex->inj_mtx);
+    exec_notify(ex, 1);
+
+    while (!atomic_load_explicit(&r->done, memory_order_acquire)) {
+        futex_wait(&r->done, 0, NULL);
+    }
+}
+
+static void exec_root_init(ExecRoot* r, const struct OSAL_Executor* ex, uint32_t begin, uint32_t end,
+                           uint32_t grain, void* arg)
+{
+    memset(r, 0, sizeof(*r));
+    if (!grain) {
+        // ~8 phần mỗi worker: đủ để cân tải mà chi phí chia vẫn nhỏ
+        uint64_t parts = (uint64_t)ex->nworkers * 8u;
+        grain = (uint32_t)(((uint64_t)(end - begin) + parts - 1) / parts);
+        if (!grain) grain = 1;
+    }
+    r->arg          = arg;
+    r->grain        = grain;
+    r->remaining    = (uint64_t)(end - begin);
+    r->job.root     = r;
+    r->job.begin    = begin;
+    r->job.end      = end;
+    r->job.embedded = 1;
+}
+
+OSAL_Status OSAL_ExecParallelFor(OSAL_ExecHandle ex, uint32_t begin, uint32_t end, uint32_t grain,
+                                 OSAL_ExecRangeFn fn, void* arg)
+{
+    if (!ex || !fn || end < begin || exec_in_reduce(ex)) return OSAL_EINVAL;
+    if (end == begin) return OSAL_OK;
+
+    ExecRoot r;
+    exec_root_init(&r, ex, begin, end, grain, arg);
+    r.fn = fn;
+    exec_submit_wait(ex, &r);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_ExecParallelReduce(OSAL_ExecHandle ex, uint32_t begin, uint32_t end, uint32_t grain,
+                                    OSAL_ExecReduceFn fn, OSAL_ExecCombineFn combine, void* arg,
+                                    const void* identity, void* result, size_t size)
+{
+    if (!ex || !fn || !combine || !identity || !result || !size || end < begin || exec_in_reduce(ex)) {
+        return OSAL_EINVAL;
+    }
+
+    memmove(result, identity, size);
+    if (end == begin) return OSAL_OK;
+
+    // Partial riêng mỗi worker, mỗi cái một cache line riêng → không false sharing
+    size_t stride = (size + OSAL_EXEC_CACHELINE - 1) / OSAL_EXEC_CACHELINE * OSAL_EXEC_CACHELINE;
+    char* buf = (char*)aligned_alloc(OSAL_EXEC_CACHELINE, stride * ex->nworkers + OSAL_EXEC_CACHELINE);
+    if (!buf) return OSAL_ENOMEM;
+
+    ExecRoot r;
+    exec_root_init(&r, ex, begin, end, grain, arg);
+    r.reduce   = fn;
+    r.identity = identity;
+    r.size     = size;
+    r.stride   = stride;
+    r.partials = buf;
+    r.touched  = (uint8_t*)(buf + stride * ex->nworkers);
+    memset(r.touched, 0, ex->nworkers);
+    exec_submit_wait(ex, &r);
+
+    for (uint32_t i = 0; i < ex->nworkers; ++i) {
+        if (r.touched[i]) combine(result, r.partials + (size_t)i * stride, arg);
+    }
+    free(buf);
+    return OSAL_OK;
+}
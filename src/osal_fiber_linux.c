@@ -0,0 +1,627 @@
+// OSAL fiber (M:N) cho Linux
+// - Nhiều fiber chạy trên vài carrier thread; mỗi fiber ghim vào một carrier (chọn carrier ít fiber nhất)
+// - Chuyển ngữ cảnh user-space: asm cho x86_64 / aarch64 (chỉ lưu thanh ghi callee-saved), các kiến
+//   trúc khác dùng ucontext (chậm hơn: swapcontext gọi sigprocmask mỗi lần chuyển). arm 32 bit có asm
+//   (r4-r11, lr và d8-d15 khi có VFP) nhưng chỉ bật với -DOSAL_FIBER_ARM_ASM: chưa chạy thử trên board
+// - Ready list theo rank (0 = cao nhất): bitmap 256 bit + FIFO mỗi mức → chọn fiber O(1)
+// - Fiber ngủ nằm trong min-heap theo deadline; carrier rảnh chờ trên condvar CLOCK_MONOTONIC
+// - Quy ước khoá: mọi lần chuyển fiber <-> carrier đều diễn ra khi đang giữ c->mtx (cùng một thread OS)
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE     // pthread_setname_np
+#endif
+
+#include "osal_linux_priv.h"
+#include "osal.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#if defined(__arm__) && defined(OSAL_FIBER_ARM_ASM)
+#define OSAL_FIBER_ASM_ARM 1
+#endif
+
+#if !defined(__x86_64__) && !defined(__aarch64__) && !defined(OSAL_FIBER_ASM_ARM)
+#include <ucontext.h>
+#define OSAL_FIBER_UCONTEXT 1
+#endif
+
+// arm 32 bit: d8-d15 là callee-saved khi có VFP (hard-float lẫn softfp); -mfloat-abi=soft thì không có
+#if defined(OSAL_FIBER_ASM_ARM)
+#if defined(__ARM_FP) && !defined(__SOFTFP__)
+#define OSAL_FIBER_ARM_VFP   1
+#define OSAL_FIBER_ARM_FRAME (64 + 36)      // d8-d15 + r4-r11, lr
+#else
+#define OSAL_FIBER_ARM_FRAME 36
+#endif
+#endif
+
+// Số carrier thread (0 = số CPU online), tối đa OSAL_FIBER_MAX_CARRIERS
+#ifndef OSAL_FIBER_CARRIERS
+#define OSAL_FIBER_CARRIERS 0
+#endif
+
+#ifndef OSAL_FIBER_MAX_CARRIERS
+#define OSAL_FIBER_MAX_CARRIERS 8
+#endif
+
+// osal_fiber_backoff: số lần yield trước khi chuyển sang ngủ ngắn, và khoảng ngủ
+#ifndef OSAL_FIBER_BACKOFF_SPIN
+#define OSAL_FIBER_BACKOFF_SPIN 16u
+#endif
+#ifndef OSAL_FIBER_BACKOFF_POLL_US
+#define OSAL_FIBER_BACKOFF_POLL_US 100u
+#endif
+
+#define FIBER_NRANK 256u
+
+enum { FIB_NEW = 0, FIB_READY, FIB_RUNNING, FIB_SLEEP, FIB_PARK, FIB_EXIT };
+
+typedef struct FiberCarrier FiberCarrier;
+
+struct OsalFiber {
+    void*          sp;            // stack pointer đã lưu (asm)
+#ifdef OSAL_FIBER_UCONTEXT
+    ucontext_t     uc;
+#endif
+    OsalStack      stack;
+    FiberCarrier*  c;
+    void         (*entry)(void*);
+    void*          arg;
+    void         (*done)(void*);
+    void*          owner;
+    uint8_t        rank;
+    uint8_t        state;         // FIB_*
+    uint8_t        wake_pending;  // permit: wake đến trước park/sleep
+    uint8_t        timed_out;
+    OsalFiber*     prev;          // ready list
+    OsalFiber*     next;
+    uint32_t       heap_idx;      // vị trí trong timer heap + 1 (0 = không nằm trong heap)
+    uint64_t       wake_ns;
+    uint64_t       run_ns;        // tổng thời gian đã chạy trên carrier
+};
+
+struct FiberCarrier {
+    pthread_mutex_t mtx;
+    pthread_cond_t  cv;           // carrier rảnh chờ việc / deadline timer
+    uint8_t         idle;
+    pthread_t       tid;
+    void*           sched_sp;     // ngữ cảnh vòng lập lịch của carrier
+#ifdef OSAL_FIBER_UCONTEXT
+    ucontext_t      sched_uc;
+#endif
+    uint64_t        bitmap[FIBER_NRANK / 64];
+    OsalFiber*      head[FIBER_NRANK];
+    OsalFiber*      tail[FIBER_NRANK];
+    OsalFiber**     heap;         // min-heap theo wake_ns
+    uint32_t        heap_n;
+    uint32_t        heap_cap;
+    _Atomic uint32_t nfibers;     // để chọn carrier ít tải nhất
+};
+
+static FiberCarrier*  g_carriers  = NULL;
+static uint32_t       g_ncarriers = 0;
+static int            g_carrier_err = 0;
+static pthread_once_t g_carrier_once = PTHREAD_ONCE_INIT;
+
+// Fiber đang chạy trên thread này (NULL ở vòng lập lịch / thread thường)
+static __thread OsalFiber* tls_fiber = NULL;
+
+// ===== Chuyển ngữ cảnh =====
+
+#if defined(__x86_64__)
+// void osal_fiber_switch_asm(void** save_sp, void* new_sp)
+__asm__(
+    ".text\n"
+    ".globl osal_fiber_switch_asm\n"
+    ".hidden osal_fiber_switch_asm\n"
+    ".type osal_fiber_switch_asm,@function\n"
+    "osal_fiber_switch_asm:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size osal_fiber_switch_asm,.-osal_fiber_switch_asm\n");
+#elif defined(__aarch64__)
+__asm__(
+    ".text\n"
+    ".globl osal_fiber_switch_asm\n"
+    ".hidden osal_fiber_switch_asm\n"
+    ".type osal_fiber_switch_asm,%function\n"
+    "osal_fiber_switch_asm:\n"
+    "    sub sp, sp, #160\n"
+    "    stp x19, x20, [sp, #0]\n"
+    "    stp x21, x22, [sp, #16]\n"
+    "    stp x23, x24, [sp, #32]\n"
+    "    stp x25, x26, [sp, #48]\n"
+    "    stp x27, x28, [sp, #64]\n"
+    "    stp x29, x30, [sp, #80]\n"
+    "    stp d8,  d9,  [sp, #96]\n"
+    "    stp d10, d11, [sp, #112]\n"
+    "    stp d12, d13, [sp, #128]\n"
+    "    stp d14, d15, [sp, #144]\n"
+    "    mov x9, sp\n"
+    "    str x9, [x0]\n"
+    "    mov sp, x1\n"
+    "    ldp x19, x20, [sp, #0]\n"
+    "    ldp x21, x22, [sp, #16]\n"
+    "    ldp x23, x24, [sp, #32]\n"
+    "    ldp x25, x26, [sp, #48]\n"
+    "    ldp x27, x28, [sp, #64]\n"
+    "    ldp x29, x30, [sp, #80]\n"
+    "    ldp d8,  d9,  [sp, #96]\n"
+    "    ldp d10, d11, [sp, #112]\n"
+    "    ldp d12, d13, [sp, #128]\n"
+    "    ldp d14, d15, [sp, #144]\n"
+    "    add sp, sp, #160\n"
+    "    ret\n"
+    ".size osal_fiber_switch_asm,.-osal_fiber_switch_asm\n");
+#elif defined(OSAL_FIBER_ASM_ARM)
+// ARM mode (gọi được từ code Thumb-2 qua interworking), về bằng bx lr
+__asm__(
+    ".text\n"
+    ".syntax unified\n"
+    ".arm\n"
+    ".align 2\n"
+    ".globl osal_fiber_switch_asm\n"
+    ".hidden osal_fiber_switch_asm\n"
+    ".type osal_fiber_switch_asm,%function\n"
+    "osal_fiber_switch_asm:\n"
+    "    push {r4-r11, lr}\n"
+#ifdef OSAL_FIBER_ARM_VFP
+    "    vpush {d8-d15}\n"
+#endif
+    "    str sp, [r0]\n"
+    "    mov sp, r1\n"
+#ifdef OSAL_FIBER_ARM_VFP
+    "    vpop {d8-d15}\n"
+#endif
+    "    pop {r4-r11, lr}\n"
+    "    bx lr\n"
+    ".size osal_fiber_switch_asm,.-osal_fiber_switch_asm\n");
+#endif
+
+#ifndef OSAL_FIBER_UCONTEXT
+void osal_fiber_switch_asm(void** save_sp, void* new_sp);
+#endif
+
+static void fiber_boot(void);
+
+// Dựng frame ban đầu sao cho lần chuyển đầu tiên "return" vào fiber_boot
+static void fiber_ctx_init(OsalFiber* f)
+{
+#if defined(__x86_64__)
+    uint64_t* sp = (uint64_t*)(((uintptr_t)f->stack.base + f->stack.size) & ~(uintptr_t)15);
+    *--sp = 0;                               // địa chỉ trả về giả của fiber_boot (không bao giờ return)
+    *--sp = (uint64_t)(uintptr_t)fiber_boot; // ret → fiber_boot, rsp ≡ 8 (mod 16) như sau lệnh call
+    for (int i = 0; i < 6; ++i) *--sp = 0;   // rbp, rbx, r12..r15
+    f->sp = sp;
+#elif defined(__aarch64__)
+    uint64_t* sp = (uint64_t*)((((uintptr_t)f->stack.base + f->stack.size) & ~(uintptr_t)15) - 160);
+    memset(sp, 0, 160);
+    sp[11] = (uint64_t)(uintptr_t)fiber_boot;   // x30 (lr)
+    f->sp = sp;
+#elif defined(OSAL_FIBER_ASM_ARM)
+    // [d8-d15] r4..r11 lr từ thấp lên cao; pop xong sp = đỉnh stack (căn 8 theo AAPCS)
+    uint32_t* sp = (uint32_t*)((((uintptr_t)f->stack.base + f->stack.size) & ~(uintptr_t)15) - OSAL_FIBER_ARM_FRAME);
+    memset(sp, 0, OSAL_FIBER_ARM_FRAME);
+    sp[OSAL_FIBER_ARM_FRAME / 4 - 1] = (uint32_t)(uintptr_t)fiber_boot;   // lr (bit 0 = Thumb, bx xử lý)
+    f->sp = sp;
+#else
+    getcontext(&f->uc);
+    f->uc.uc_stack.ss_sp   = f->stack.base;
+    f->uc.uc_stack.ss_size = f->stack.size;
+    f->uc.uc_link          = NULL;
+    makecontext(&f->uc, fiber_boot, 0);
+#endif
+}
+
+// Carrier → fiber (giữ c->mtx)
+static inline void fiber_switch_in(FiberCarrier* c, OsalFiber* f)
+{
+#ifdef OSAL_FIBER_UCONTEXT
+    swapcontext(&c->sched_uc, &f->uc);
+#else
+    osal_fiber_switch_asm(&c->sched_sp, f->sp);
+#endif
+}
+
+// Fiber → carrier (giữ c->mtx); trả về khi carrier chọn lại fiber này
+static inline void fiber_switch_out(OsalFiber* f)
+{
+#ifdef OSAL_FIBER_UCONTEXT
+    swapcontext(&f->uc, &f->c->sched_uc);
+#else
+    osal_fiber_switch_asm(&f->sp, f->c->sched_sp);
+#endif
+}
+
+// ===== Ready list (bitmap + FIFO theo rank) =====
+
+static void ready_push_locked(FiberCarrier* c, OsalFiber* f)
+{
+    uint8_t r = f->rank;
+    f->state = FIB_READY;
+    f->next  = NULL;
+    f->prev  = c->tail[r];
+    if (c->tail[r]) c->tail[r]->next = f;
+    else            c->head[r] = f;
+    c->tail[r] = f;
+    c->bitmap[r >> 6] |= 1ull << (r & 63u);
+}
+
+static void ready_remove_locked(FiberCarrier* c, OsalFiber* f)
+{
+    uint8_t r = f->rank;
+    if (f->prev) f->prev->next = f->next;
+    else         c->head[r]    = f->next;
+    if (f->next) f->next->prev = f->prev;
+    else         c->tail[r]    = f->prev;
+    f->prev = f->next = NULL;
+    if (!c->head[r]) c->bitmap[r >> 6] &= ~(1ull << (r & 63u));
+}
+
+static OsalFiber* ready_pop_locked(FiberCarrier* c)
+{
+    for (uint32_t w = 0; w < FIBER_NRANK / 64; ++w) {
+        if (!c->bitmap[w]) continue;
+        OsalFiber* f = c->head[w * 64u + (uint32_t)__builtin_ctzll(c->bitmap[w])];
+        ready_remove_locked(c, f);
+        return f;
+    }
+    return NULL;
+}
+
+// ===== Timer heap =====
+
+static inline void heap_set(FiberCarrier* c, uint32_t i, OsalFiber* f)
+{
+    c->heap[i]  = f;
+    f->heap_idx = i + 1;
+}
+
+static void heap_sift_up(FiberCarrier* c, uint32_t i)
+{
+    OsalFiber* f = c->heap[i];
+    while (i > 0) {
+        uint32_t p = (i - 1) / 2;
+        if (c->heap[p]->wake_ns <= f->wake_ns) break;
+        heap_set(c, i, c->heap[p]);
+        i = p;
+    }
+    heap_set(c, i, f);
+}
+
+static void heap_sift_down(FiberCarrier* c, uint32_t i)
+{
+    OsalFiber* f = c->heap[i];
+    for (;;) {
+        uint32_t l = 2 * i + 1;
+        if (l >= c->heap_n) break;
+        uint32_t m = (l + 1 < c->heap_n && c->heap[l + 1]->wake_ns < c->heap[l]->wake_ns) ? l + 1 : l;
+        if (f->wake_ns <= c->heap[m]->wake_ns) break;
+        heap_set(c, i, c->heap[m]);
+        i = m;
+    }
+    heap_set(c, i, f);
+}
+
+static int heap_push_locked(FiberCarrier* c, OsalFiber* f)
+{
+    if (c->heap_n == c->heap_cap) {
+        uint32_t cap = c->heap_cap ? c->heap_cap * 2u : 64u;
+        OsalFiber** h = (OsalFiber**)realloc(c->heap, cap * sizeof(*h));
+        if (!h) return 0;
+        c->heap     = h;
+        c->heap_cap = cap;
+    }
+    c->heap[c->heap_n] = f;
+    heap_sift_up(c, c->heap_n++);
+    return 1;
+}
+
+static void heap_remove_locked(FiberCarrier* c, OsalFiber* f)
+{
+    uint32_t i = f->heap_idx - 1;
+    f->heap_idx = 0;
+    if (--c->heap_n == i) return;
+    heap_set(c, i, c->heap[c->heap_n]);
+    heap_sift_up(c, i);
+    heap_sift_down(c, c->heap[i]->heap_idx - 1);
+}
+
+// Đưa fiber đang SLEEP/PARK về ready; đánh thức carrier nếu nó đang rảnh
+static void fiber_make_ready_locked(FiberCarrier* c, OsalFiber* f)
+{
+    if (f->heap_idx) heap_remove_locked(c, f);
+    ready_push_locked(c, f);
+    if (c->idle) pthread_cond_signal(&c->cv);
+}
+
+// ===== Carrier =====
+
+static void* carrier_main(void* arg)
+{
+    FiberCarrier* c = (FiberCarrier*)arg;
+
+    pthread_mutex_lock(&c->mtx);
+    for (;;) {
+        uint64_t now = mono_ns();
+        while (c->heap_n && c->heap[0]->wake_ns <= now) {
+            OsalFiber* f = c->heap[0];
+            f->timed_out = 1;
+            heap_remove_locked(c, f);
+            ready_push_locked(c, f);
+        }
+
+        OsalFiber* f = ready_pop_locked(c);
+        if (!f) {
+            c->idle = 1;
+            if (c->heap_n) {
+                uint64_t ns = c->heap[0]->wake_ns;
+                struct timespec ts = { (time_t)(ns / 1000000000ull), (long)(ns % 1000000000ull) };
+                pthread_cond_timedwait(&c->cv, &c->mtx, &ts);
+            } else {
+                pthread_cond_wait(&c->cv, &c->mtx);
+            }
+            c->idle = 0;
+            continue;
+        }
+
+        f->state  = FIB_RUNNING;
+        tls_fiber = f;
+        fiber_switch_in(c, f);     // trở lại khi fiber yield/park/sleep/exit, vẫn giữ c->mtx
+        tls_fiber = NULL;
+        f->run_ns += mono_ns() - now;
+
+        if (f->state == FIB_EXIT) {
+            atomic_fetch_sub(&c->nfibers, 1u);
+            pthread_mutex_unlock(&c->mtx);
+            f->done(f->owner);     // sau lời gọi này f có thể đã bị destroy
+            pthread_mutex_lock(&c->mtx);
+        }
+    }
+    return NULL;
+}
+
+static void carriers_init(void)
+{
+    uint32_t n = OSAL_FIBER_CARRIERS;
+    if (!n) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        n = (cpus > 0) ? (uint32_t)cpus : 1u;
+    }
+    if (n > OSAL_FIBER_MAX_CARRIERS) n = OSAL_FIBER_MAX_CARRIERS;
+
+    g_carriers = (FiberCarrier*)calloc(n, sizeof(FiberCarrier));
+    if (!g_carriers) {
+        g_carrier_err = ENOMEM;
+        return;
+    }
+
+    pthread_condattr_t ca;
+    pthread_condattr_init(&ca);
+    pthread_condattr_setclock(&ca, CLOCK_MONOTONIC);
+    for (uint32_t i = 0; i < n; ++i) {
+        FiberCarrier* c = &g_carriers[i];
+        pthread_mutex_init(&c->mtx, NULL);
+        pthread_cond_init(&c->cv, &ca);
+        int rc = pthread_create(&c->tid, NULL, carrier_main, c);
+        if (rc != 0) {
+            OSAL_LOG("[OSAL][Fiber] create carrier %u failed rc=%d\r\n", (unsigned)i, rc);
+            if (i == 0) g_carrier_err = rc;
+            break;
+        }
+        pthread_detach(c->tid);
+#if defined(__linux__)
+        char name[16];
+        snprintf(name, sizeof(name), "osal-fiber/%u", (unsigned)i);
+        pthread_setname_np(c->tid, name);
+#endif
+        g_ncarriers = i + 1;
+    }
+    pthread_condattr_destroy(&ca);
+}
+
+static FiberCarrier* pick_carrier(void)
+{
+    FiberCarrier* best = &g_carriers[0];
+    for (uint32_t i = 1; i < g_ncarriers; ++i) {
+        if (atomic_load(&g_carriers[i].nfibers) < atomic_load(&best->nfibers)) best = &g_carriers[i];
+    }
+    return best;
+}
+
+// Lần chạy đầu tiên của fiber: carrier vừa chuyển vào khi đang giữ c->mtx
+static void fiber_boot(void)
+{
+    OsalFiber* f = tls_fiber;
+    pthread_mutex_unlock(&f->c->mtx);
+    f->entry(f->arg);
+    osal_fiber_exit();
+}
+
+// ===== API nội bộ =====
+
+int osal_fiber_create(OsalFiber** out, size_t stack_size, uint8_t rank,
+                      void (*entry)(void*), void* arg, void (*done)(void*), void* owner)
+{
+    if (!out || !entry || !done || !stack_size) return EINVAL;
+    pthread_once(&g_carrier_once, carriers_init);
+    if (!g_ncarriers) return g_carrier_err ? g_carrier_err : EAGAIN;
+
+    OsalFiber* f = (OsalFiber*)calloc(1, sizeof(*f));
+    if (!f) return ENOMEM;
+    int err = osal_stack_alloc_small(stack_size, &f->stack);
+    if (err) {
+        free(f);
+        return err;
+    }
+    f->entry = entry;
+    f->arg   = arg;
+    f->done  = done;
+    f->owner = owner;
+    f->rank  = rank;
+    f->state = FIB_NEW;
+    f->c     = pick_carrier();
+    atomic_fetch_add(&f->c->nfibers, 1u);
+    fiber_ctx_init(f);
+    *out = f;
+    return 0;
+}
+
+void osal_fiber_start(OsalFiber* f)
+{
+    FiberCarrier* c = f->c;
+    pthread_mutex_lock(&c->mtx);
+    if (f->state == FIB_NEW) fiber_make_ready_locked(c, f);
+    pthread_mutex_unlock(&c->mtx);
+}
+
+void osal_fiber_destroy(OsalFiber* f)
+{
+    if (!f) return;
+    if (f->state == FIB_NEW) atomic_fetch_sub(&f->c->nfibers, 1u);
+    osal_stack_free(&f->stack);
+    free(f);
+}
+
+OsalFiber* osal_fiber_self(void)
+{
+    return tls_fiber;
+}
+
+void* osal_fiber_owner(const OsalFiber* f)
+{
+    return f->owner;
+}
+
+pthread_t osal_fiber_carrier(const OsalFiber* f)
+{
+    return f->c->tid;
+}
+
+uint64_t osal_fiber_run_ns(const OsalFiber* f)
+{
+    FiberCarrier* c = f->c;
+    pthread_mutex_lock(&c->mtx);
+    uint64_t ns = f->run_ns;
+    pthread_mutex_unlock(&c->mtx);
+    return ns;
+}
+
+void osal_fiber_set_rank(OsalFiber* f, uint8_t rank)
+{
+    FiberCarrier* c = f->c;
+    pthread_mutex_lock(&c->mtx);
+    if (f->state == FIB_READY) {
+        ready_remove_locked(c, f);
+        f->rank = rank;
+        ready_push_locked(c, f);
+    } else {
+        f->rank = rank;
+    }
+    pthread_mutex_unlock(&c->mtx);
+}
+
+void osal_fiber_yield(void)
+{
+    OsalFiber* f = tls_fiber;
+    if (!f) return;
+    pthread_mutex_lock(&f->c->mtx);
+    ready_push_locked(f->c, f);
+    fiber_switch_out(f);
+    pthread_mutex_unlock(&f->c->mtx);
+}
+
+void osal_fiber_park(void)
+{
+    OsalFiber* f = tls_fiber;
+    if (!f) return;
+    pthread_mutex_lock(&f->c->mtx);
+    if (!f->wake_pending) {
+        f->state = FIB_PARK;
+        fiber_switch_out(f);
+    }
+    f->wake_pending = 0;
+    pthread_mutex_unlock(&f->c->mtx);
+}
+
+int osal_fiber_sleep_until(uint64_t deadline_ns)
+{
+    OsalFiber* f = tls_fiber;
+    if (!f) return 1;
+    FiberCarrier* c = f->c;
+    int expired;
+
+    pthread_mutex_lock(&c->mtx);
+    if (f->wake_pending) {
+        expired = 0;
+    } else {
+        f->state     = FIB_SLEEP;
+        f->wake_ns   = deadline_ns;
+        f->timed_out = 0;
+        if (!heap_push_locked(c, f)) {
+            // Hết bộ nhớ cho heap → coi như ngủ xong ngay (vòng chờ phía trên tự thử lại)
+            f->state = FIB_RUNNING;
+            pthread_mutex_unlock(&c->mtx);
+            return mono_ns() >= deadline_ns;
+        }
+        fiber_switch_out(f);
+        expired = f->timed_out;
+    }
+    f->wake_pending = 0;
+    pthread_mutex_unlock(&c->mtx);
+    return expired;
+}
+
+int osal_fiber_backoff(uint32_t* spin, uint64_t deadline_ns)
+{
+    uint64_t now = mono_ns();
+    if (deadline_ns && now >= deadline_ns) return 1;
+    if ((*spin)++ < OSAL_FIBER_BACKOFF_SPIN) {
+        osal_fiber_yield();
+    } else {
+        uint64_t wake = now + OSAL_FIBER_BACKOFF_POLL_US * 1000ull;
+        osal_fiber_sleep_until((deadline_ns && deadline_ns < wake) ? deadline_ns : wake);
+    }
+    return 0;
+}
+
+void osal_fiber_wake(OsalFiber* f)
+{
+    FiberCarrier* c = f->c;
+    pthread_mutex_lock(&c->mtx);
+    if (f->state == FIB_PARK || f->state == FIB_SLEEP) {
+        fiber_make_ready_locked(c, f);
+    } else if (f->state != FIB_EXIT) {
+        f->wake_pending = 1;
+    }
+    pthread_mutex_unlock(&c->mtx);
+}
+
+void osal_fiber_exit(void)
+{
+    OsalFiber* f = tls_fiber;
+    pthread_mutex_lock(&f->c->mtx);
+    f->state = FIB_EXIT;
+    fiber_switch_out(f);
+    __builtin_unreachable();
+}
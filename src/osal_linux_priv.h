@@ -0,0 +1,112 @@
+// Khai báo nội bộ dùng chung giữa các file backend Linux (không phải API public)
+#pragma once
+
+#include "osal_prio.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// ===== Thời gian (CLOCK_MONOTONIC) =====
+static inline uint64_t mono_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline void timespec_add_ms(struct timespec* ts, uint32_t ms)
+{
+    ts->tv_sec  += (time_t)(ms / 1000u);
+    ts->tv_nsec += (long)(ms % 1000u) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_nsec -= 1000000000L;
+        ts->tv_sec  += 1;
+    }
+}
+
+// ===== Futex (private, trong process) =====
+static inline long futex_wait(_Atomic int* addr, int val, const struct timespec* rel)
+{
+    return syscall(SYS_futex, (int*)addr, FUTEX_WAIT_PRIVATE, val, rel, NULL, 0);
+}
+
+// Chờ với deadline tuyệt đối CLOCK_MONOTONIC (NULL = vô hạn) → không trôi khi bị đánh thức giả
+static inline long futex_wait_abs(_Atomic int* addr, int val, const struct timespec* abs)
+{
+    return syscall(SYS_futex, (int*)addr, FUTEX_WAIT_BITSET_PRIVATE, val, abs, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+static inline long futex_wake(_Atomic int* addr, int n)
+{
+    return syscall(SYS_futex, (int*)addr, FUTEX_WAKE_PRIVATE, n, NULL, NULL, 0);
+}
+
+// Áp dụng prio (theo quy ước backend) cho thread; thử band rt trước, thiếu quyền → band fallback.
+// Trả về 0: rt ok, 1: dùng fallback, -1: lỗi. applied (có thể NULL) nhận mapping thực tế.
+int osal_prio_apply(pthread_t tid, pid_t ktid, uint8_t prio, OSAL_PrioMapping* applied);
+// rank (0 = cao nhất .. 255) của prio theo backend hiện tại
+uint8_t osal_prio_rank(uint8_t prio);
+
+// ===== Preemptive suspend (osal_task_linux.c) =====
+// Bao vùng giữ khoá mà signal suspend không được đỗ thread giữa chừng (vd: đang giữ OSAL_Mutex).
+// Lồng nhau được; signal đến trong vùng chỉ được ghi lại, thread đỗ khi ra khỏi vùng ngoài cùng.
+void osal_task_nopark_enter(void);
+void osal_task_nopark_exit(void);
+
+// ===== Profile real-time (osal_rt_linux.c) =====
+// Áp dụng g_osal.cfg.rt (gọi từ OSAL_Init)
+void   osal_rt_apply(void);
+// Stack cho task không chỉ định stack_size: 0 = mặc định pthread (profile RT tắt)
+size_t osal_rt_task_stack(void);
+
+// ===== Stack provider (osal_stack_linux.c) =====
+typedef struct {
+    char*   base;       // đáy vùng stack dùng được (truyền cho pthread_attr_setstack)
+    size_t  size;       // kích thước stack dùng được
+    char*   map;        // đầu block (kể cả guard)
+    size_t  map_size;
+    uint8_t pooled;     // 1: thuộc pool, 0: mmap riêng
+} OsalStack;
+
+// Làm tròn kích thước yêu cầu lên trang và tối thiểu PTHREAD_STACK_MIN
+size_t osal_stack_round(size_t size);
+// Cấp stack đã prefault, có guard page; trả về 0 hoặc errno
+int    osal_stack_alloc(size_t size, OsalStack* out);
+// Như osal_stack_alloc nhưng chỉ làm tròn trang, không áp sàn PTHREAD_STACK_MIN (stack fiber không chứa TLS/descriptor)
+int    osal_stack_alloc_small(size_t size, OsalStack* out);
+void   osal_stack_free(OsalStack* st);
+
+// ===== Fiber M:N (osal_fiber_linux.c) =====
+// Fiber được ghim vào một carrier thread suốt đời (không migrate → TLS của carrier luôn đúng).
+// Các hàm "điểm chuyển" (yield/park/sleep_until/exit) chỉ gọi từ chính fiber đang chạy.
+typedef struct OsalFiber OsalFiber;
+
+// Tạo fiber (chưa chạy). done(owner) được carrier gọi sau khi fiber kết thúc và đã rời stack của nó.
+// Trả về 0 hoặc errno
+int        osal_fiber_create(OsalFiber** out, size_t stack_size, uint8_t rank,
+                             void (*entry)(void*), void* arg, void (*done)(void*), void* owner);
+void       osal_fiber_start(OsalFiber* f);
+// Giải phóng fiber đã kết thúc (sau done)
+void       osal_fiber_destroy(OsalFiber* f);
+OsalFiber* osal_fiber_self(void);
+void*      osal_fiber_owner(const OsalFiber* f);
+pthread_t  osal_fiber_carrier(const OsalFiber* f);
+uint64_t   osal_fiber_run_ns(const OsalFiber* f);
+void       osal_fiber_set_rank(OsalFiber* f, uint8_t rank);
+void       osal_fiber_yield(void);
+// Đỗ đến khi osal_fiber_wake (wake đến trước thì trả về ngay: kiểu "permit")
+void       osal_fiber_park(void);
+// Ngủ đến deadline (ns, CLOCK_MONOTONIC) hoặc osal_fiber_wake; trả về 1 nếu hết hạn
+int        osal_fiber_sleep_until(uint64_t deadline_ns);
+void       osal_fiber_wake(OsalFiber* f);
+// Một bước chờ thăm dò cho primitive không có hàng đợi fiber (mutex, semaphore...): yield vài lần đầu,
+// sau đó ngủ ngắn để carrier không quay vòng khi rảnh. spin: bộ đếm của vòng chờ (khởi tạo 0),
+// deadline_ns: CLOCK_MONOTONIC (0 = vô hạn). Trả về 1 nếu đã qua deadline.
+int        osal_fiber_backoff(uint32_t* spin, uint64_t deadline_ns);
+void       osal_fiber_exit(void) __attribute__((noreturn));
@@ -0,0 +1,189 @@
+// OSAL mutex cho Linux (futex PI)
+// - futex word = TID kernel của chủ | FUTEX_WAITERS (giao thức PI của kernel): 0 → tid bằng CAS là Lock,
+//   tid → 0 bằng CAS là Unlock; chỉ khi có người chờ mới vào kernel (FUTEX_LOCK_PI / FUTEX_UNLOCK_PI)
+// - Kernel giữ rt_mutex cho word đó → chủ được boost prio, Unlock trao thẳng mutex cho người chờ cao nhất
+// - Timeout: FUTEX_LOCK_PI2 (CLOCK_MONOTONIC, Linux >= 5.14), kernel cũ → FUTEX_LOCK_PI (CLOCK_REALTIME)
+// - owner/depth chỉ chủ ghi: nhận diện đệ quy, và phân biệt các fiber chung một carrier (chung TID)
+// - Từ lúc Lock đến Unlock cuối: preemptive suspend (OSAL_TASK_F_PREEMPT_SUSPEND) bị hoãn đến khi nhả
+
+#include "osal_mutex.h"
+#include "osal.h"
+#include "osal_linux_priv.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#ifndef FUTEX_LOCK_PI2
+#define FUTEX_LOCK_PI2 13
+#endif
+
+#ifndef OSAL_MUTEX_NAME_MAX
+#define OSAL_MUTEX_NAME_MAX 16
+#endif
+
+struct OSAL_Mutex {
+    _Atomic uint32_t  word;        // futex PI
+    _Atomic uintptr_t owner;       // fiber / pthread_self của chủ (0 = tự do)
+    uint32_t          depth;       // số lần Lock lồng nhau của chủ
+    uint8_t           recursive;
+    char              name[OSAL_MUTEX_NAME_MAX];
+};
+
+static __thread pid_t  tls_tid = 0;
+static _Atomic int     g_no_pi2 = 0;      // kernel không có FUTEX_LOCK_PI2
+
+static inline pid_t self_tid(void)
+{
+    if (!tls_tid) tls_tid = (pid_t)syscall(SYS_gettid);
+    return tls_tid;
+}
+
+// Danh tính của chủ: fiber nếu đang chạy trên fiber (nhiều fiber chung TID carrier), ngược lại thread
+static inline uintptr_t self_id(void)
+{
+    OsalFiber* f = osal_fiber_self();
+    return f ? (uintptr_t)f : (uintptr_t)pthread_self();
+}
+
+static inline int try_acquire(struct OSAL_Mutex* m, pid_t tid)
+{
+    uint32_t expect = 0;
+    return atomic_compare_exchange_strong_explicit(&m->word, &expect, (uint32_t)tid,
+                                                   memory_order_acquire, memory_order_relaxed);
+}
+
+// Chờ trong kernel (PI) đến deadline CLOCK_MONOTONIC (NULL = vô hạn); 0 hoặc errno
+static int lock_pi_wait(struct OSAL_Mutex* m, const struct timespec* deadline)
+{
+    for (;;) {
+        long rc;
+        if (!atomic_load_explicit(&g_no_pi2, memory_order_relaxed)) {
+            rc = syscall(SYS_futex, (uint32_t*)&m->word, FUTEX_LOCK_PI2 | FUTEX_PRIVATE_FLAG, 0, deadline, NULL, 0);
+            if (rc != 0 && errno == ENOSYS) {
+                atomic_store(&g_no_pi2, 1);
+                continue;
+            }
+        } else {
+            // FUTEX_LOCK_PI chỉ nhận deadline CLOCK_REALTIME → đổi từ phần còn lại của deadline monotonic
+            struct timespec rt, *prt = NULL;
+            if (deadline) {
+                struct timespec now;
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                int64_t left = ((int64_t)deadline->tv_sec - now.tv_sec) * 1000000000ll +
+                               (deadline->tv_nsec - now.tv_nsec);
+                if (left < 0) left = 0;
+                clock_gettime(CLOCK_REALTIME, &rt);
+                int64_t ns = (int64_t)rt.tv_nsec + left;
+                rt.tv_sec  += (time_t)(ns / 1000000000ll);
+                rt.tv_nsec  = (long)(ns % 1000000000ll);
+                prt = &rt;
+            }
+            rc = syscall(SYS_futex, (uint32_t*)&m->word, FUTEX_LOCK_PI_PRIVATE, 0, prt, NULL, 0);
+        }
+        if (rc == 0) return 0;
+        if (errno != EINTR && errno != EAGAIN) return errno;   // EAGAIN: chủ đang thoát, thử lại
+    }
+}
+
+// Fiber không được block carrier (chủ có thể là fiber khác trên cùng carrier) → nhường rồi thử lại
+static int lock_fiber_wait(struct OSAL_Mutex* m, pid_t tid, uint32_t timeout_ms)
+{
+    uint64_t deadline = (timeout_ms == OSAL_WAIT_FOREVER) ? 0 : mono_ns() + (uint64_t)timeout_ms * 1000000ull;
+    uint32_t spin = 0;
+    while (!try_acquire(m, tid)) {
+        if (osal_fiber_backoff(&spin, deadline)) return ETIMEDOUT;
+    }
+    return 0;
+}
+
+OSAL_Status OSAL_MutexCreate(OSAL_MutexHandle* out, const OSAL_MutexAttr* attr)
+{
+    if (!out) return OSAL_EINVAL;
+    struct OSAL_Mutex* m = (struct OSAL_Mutex*)calloc(1, sizeof(*m));
+    if (!m) return OSAL_ENOMEM;
+    if (attr) {
+        m->recursive = (attr->flags & OSAL_MUTEX_F_RECURSIVE) ? 1 : 0;
+        if (attr->name) strncpy(m->name, attr->name, sizeof(m->name) - 1);
+    }
+    *out = m;
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_MutexDelete(OSAL_MutexHandle m)
+{
+    if (!m) return OSAL_EINVAL;
+    if (atomic_load(&m->word) != 0) return OSAL_EBUSY;
+    free(m);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_MutexLockTimeout(OSAL_MutexHandle m, uint32_t timeout_ms)
+{
+    if (!m) return OSAL_EINVAL;
+    uintptr_t self = self_id();
+    if (atomic_load_explicit(&m->owner, memory_order_relaxed) == self) {
+        if (!m->recursive) return OSAL_EINVAL;
+        m->depth++;
+        return OSAL_OK;
+    }
+
+    // Vào vùng không đỗ trước khi có thể thành chủ: signal suspend đến sau CAS cũng không đỗ được chủ
+    osal_task_nopark_enter();
+    pid_t tid = self_tid();
+    if (!try_acquire(m, tid)) {
+        if (timeout_ms == 0) {
+            osal_task_nopark_exit();
+            return OSAL_ETIMEOUT;
+        }
+        int err;
+        if (osal_fiber_self()) {
+            err = lock_fiber_wait(m, tid, timeout_ms);
+        } else if (timeout_ms == OSAL_WAIT_FOREVER) {
+            err = lock_pi_wait(m, NULL);
+        } else {
+            struct timespec dl;
+            clock_gettime(CLOCK_MONOTONIC, &dl);
+            timespec_add_ms(&dl, timeout_ms);
+            err = lock_pi_wait(m, &dl);
+        }
+        if (err) {
+            osal_task_nopark_exit();
+            if (err == ETIMEDOUT) return OSAL_ETIMEOUT;
+            OSAL_LOG("[OSAL][Mutex] %s: lock failed (errno=%d)\r\n", m->name, err);
+            return (err == EDEADLK) ? OSAL_EINVAL : OSAL_EOS;
+        }
+    }
+    atomic_store_explicit(&m->owner, self, memory_order_relaxed);
+    m->depth = 1;
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_MutexLock(OSAL_MutexHandle m)
+{
+    return OSAL_MutexLockTimeout(m, OSAL_WAIT_FOREVER);
+}
+
+OSAL_Status OSAL_MutexTryLock(OSAL_MutexHandle m)
+{
+    OSAL_Status st = OSAL_MutexLockTimeout(m, 0);
+    return (st == OSAL_ETIMEOUT) ? OSAL_EBUSY : st;
+}
+
+OSAL_Status OSAL_MutexUnlock(OSAL_MutexHandle m)
+{
+    if (!m || atomic_load_explicit(&m->owner, memory_order_relaxed) != self_id()) return OSAL_EINVAL;
+    if (--m->depth > 0) return OSAL_OK;
+
+    atomic_store_explicit(&m->owner, 0, memory_order_relaxed);
+    uint32_t expect = (uint32_t)self_tid();
+    if (!atomic_compare_exchange_strong_explicit(&m->word, &expect, 0u,
+                                                 memory_order_release, memory_order_relaxed)) {
+        // Có FUTEX_WAITERS: kernel trao mutex cho người chờ ưu tiên cao nhất và bỏ boost của ta
+        syscall(SYS_futex, (uint32_t*)&m->word, FUTEX_UNLOCK_PI_PRIVATE, 0, NULL, NULL, 0);
+    }
+    osal_task_nopark_exit();    // suspend bị hoãn trong lúc giữ mutex có hiệu lực tại đây
+    return OSAL_OK;
+}
@@ -0,0 +1,245 @@
+// OSAL priority domain cho Linux
+// - Chuẩn hoá prio theo quy ước backend → rank (0 = cao nhất)
+// - Band: rank → SCHED_FIFO / SCHED_RR / nice, bảng riêng cho từng backend (compile-time, đổi được runtime)
+// - Không có CAP_SYS_NICE: dùng bảng fallback chỉ có nice → vẫn giữ thứ tự tương đối
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "osal_linux_priv.h"
+#include "osal.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+// configMAX_PRIORITIES của firmware FreeRTOS
+#ifndef OSAL_FREERTOS_MAX_PRIO
+#define OSAL_FREERTOS_MAX_PRIO 32
+#endif
+
+#ifndef OSAL_PRIO_MAX_BANDS
+#define OSAL_PRIO_MAX_BANDS 8
+#endif
+
+// ===== Bảng mặc định (compile-time) =====
+
+// uC/OS-III & Linux: 0 = cao nhất. 0..97 map 1:1 (không trùng mức), phần còn lại xuống nice.
+static const OSAL_PrioBand k_ucos_rt[] = {
+    {   0,  48, OSAL_PRIO_POLICY_FIFO,  99,  51 },
+    {  49,  97, OSAL_PRIO_POLICY_RR,    50,   2 },
+    {  98, 255, OSAL_PRIO_POLICY_OTHER, -20, 19 },
+};
+// Fallback: OS_CFG_PRIO_MAX thường là 64 → trải 64 mức lên nice 0..19
+static const OSAL_PrioBand k_ucos_fb[] = {
+    {   0,  63, OSAL_PRIO_POLICY_OTHER,  0,  19 },
+    {  64, 255, OSAL_PRIO_POLICY_OTHER, 19,  19 },
+};
+
+// FreeRTOS: rank = MAX-1-prio; prio 0 (idle) → SCHED_OTHER
+static const OSAL_PrioBand k_frtos_rt[] = {
+    {   0,  15, OSAL_PRIO_POLICY_FIFO,  99,  84 },
+    {  16,  30, OSAL_PRIO_POLICY_RR,    83,  69 },
+    {  31, 255, OSAL_PRIO_POLICY_OTHER,  0,  19 },
+};
+static const OSAL_PrioBand k_frtos_fb[] = {
+    {   0,  31, OSAL_PRIO_POLICY_OTHER,  0,  19 },
+    {  32, 255, OSAL_PRIO_POLICY_OTHER, 19,  19 },
+};
+
+typedef struct {
+    OSAL_PrioBand rt[OSAL_PRIO_MAX_BANDS];
+    uint32_t      n_rt;
+    OSAL_PrioBand fb[OSAL_PRIO_MAX_BANDS];
+    uint32_t      n_fb;
+} PrioDomain;
+
+#define NBANDS(a) ((uint32_t)(sizeof(a) / sizeof((a)[0])))
+
+// Index theo OSAL_Backend (1..3); 0 = chưa Init → coi như Linux
+static PrioDomain       g_domains[4];
+static pthread_once_t   g_domains_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t  g_domains_mtx  = PTHREAD_MUTEX_INITIALIZER;
+static _Atomic int      g_rt_denied    = 0;   // đã gặp EPERM → đi thẳng bảng fallback
+
+static void domain_load(PrioDomain* d, const OSAL_PrioBand* rt, uint32_t n_rt,
+                        const OSAL_PrioBand* fb, uint32_t n_fb)
+{
+    memcpy(d->rt, rt, n_rt * sizeof(*rt));
+    memcpy(d->fb, fb, n_fb * sizeof(*fb));
+    d->n_rt = n_rt;
+    d->n_fb = n_fb;
+}
+
+static void domains_init(void)
+{
+    domain_load(&g_domains[0],                     k_ucos_rt,  NBANDS(k_ucos_rt),  k_ucos_fb,  NBANDS(k_ucos_fb));
+    domain_load(&g_domains[OSAL_BACKEND_UCOS3],    k_ucos_rt,  NBANDS(k_ucos_rt),  k_ucos_fb,  NBANDS(k_ucos_fb));
+    domain_load(&g_domains[OSAL_BACKEND_LINUX],    k_ucos_rt,  NBANDS(k_ucos_rt),  k_ucos_fb,  NBANDS(k_ucos_fb));
+    domain_load(&g_domains[OSAL_BACKEND_FREERTOS], k_frtos_rt, NBANDS(k_frtos_rt), k_frtos_fb, NBANDS(k_frtos_fb));
+}
+
+static inline int backend_index(OSAL_Backend b)
+{
+    return (b >= OSAL_BACKEND_UCOS3 && b <= OSAL_BACKEND_LINUX) ? (int)b : 0;
+}
+
+static inline uint8_t prio_to_rank(OSAL_Backend b, uint8_t prio)
+{
+    if (b == OSAL_BACKEND_FREERTOS) {
+        uint8_t p = (prio >= OSAL_FREERTOS_MAX_PRIO) ? (uint8_t)(OSAL_FREERTOS_MAX_PRIO - 1) : prio;
+        return (uint8_t)(OSAL_FREERTOS_MAX_PRIO - 1 - p);
+    }
+    return prio;
+}
+
+// "Độ khẩn" để kiểm tra thứ tự: mọi mức RT luôn cao hơn mọi mức nice
+static inline int urgency(OSAL_PrioPolicy pol, int v)
+{
+    return (pol == OSAL_PRIO_POLICY_OTHER) ? (20 - v) : (100 + v);
+}
+
+static int band_value_valid(OSAL_PrioPolicy pol, int v)
+{
+    if (pol == OSAL_PRIO_POLICY_OTHER) return v >= -20 && v <= 19;
+    return v >= 1 && v <= 99;
+}
+
+static int bands_valid(const OSAL_PrioBand* b, uint32_t n)
+{
+    if (!b || n == 0 || n > OSAL_PRIO_MAX_BANDS) return 0;
+    if (b[0].rank_lo != 0 || b[n - 1].rank_hi != 255) return 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (b[i].rank_lo > b[i].rank_hi) return 0;
+        if (!band_value_valid(b[i].policy, b[i].first) || !band_value_valid(b[i].policy, b[i].last)) return 0;
+        if (urgency(b[i].policy, b[i].first) < urgency(b[i].policy, b[i].last)) return 0;
+        if (i > 0) {
+            if (b[i].rank_lo != b[i - 1].rank_hi + 1) return 0;
+            if (urgency(b[i].policy, b[i].first) > urgency(b[i - 1].policy, b[i - 1].last)) return 0;
+        }
+    }
+    return 1;
+}
+
+static void band_lookup(const OSAL_PrioBand* b, uint32_t n, uint8_t rank, OSAL_PrioMapping* out)
+{
+    for (uint32_t i = 0; i < n; ++i) {
+        if (rank < b[i].rank_lo || rank > b[i].rank_hi) continue;
+        int span = b[i].rank_hi - b[i].rank_lo;
+        int v = b[i].first;
+        if (span > 0) v += ((int)(rank - b[i].rank_lo) * (b[i].last - b[i].first)) / span;
+        out->policy = b[i].policy;
+        out->value  = v;
+        return;
+    }
+    out->policy = OSAL_PRIO_POLICY_OTHER;
+    out->value  = 0;
+}
+
+OSAL_Status OSAL_PrioSetBands(OSAL_Backend backend,
+                              const OSAL_PrioBand* rt, uint32_t n_rt,
+                              const OSAL_PrioBand* fb, uint32_t n_fb)
+{
+    int bi = backend_index(backend);
+    if (bi == 0 || !bands_valid(rt, n_rt) || !bands_valid(fb, n_fb)) return OSAL_EINVAL;
+    for (uint32_t i = 0; i < n_fb; ++i) {
+        if (fb[i].policy != OSAL_PRIO_POLICY_OTHER) return OSAL_EINVAL;   // fallback chỉ có nice
+    }
+
+    pthread_once(&g_domains_once, domains_init);
+    pthread_mutex_lock(&g_domains_mtx);
+    domain_load(&g_domains[bi], rt, n_rt, fb, n_fb);
+    if (bi == OSAL_BACKEND_LINUX) domain_load(&g_domains[0], rt, n_rt, fb, n_fb);
+    pthread_mutex_unlock(&g_domains_mtx);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_PrioResolve(uint8_t prio, uint8_t privileged, OSAL_PrioMapping* out)
+{
+    if (!out) return OSAL_EINVAL;
+    pthread_once(&g_domains_once, domains_init);
+
+    OSAL_Backend b = g_osal.cfg.backend;
+    uint8_t rank   = prio_to_rank(b, prio);
+
+    pthread_mutex_lock(&g_domains_mtx);
+    const PrioDomain* d = &g_domains[backend_index(b)];
+    if (privileged) band_lookup(d->rt, d->n_rt, rank, out);
+    else            band_lookup(d->fb, d->n_fb, rank, out);
+    pthread_mutex_unlock(&g_domains_mtx);
+    return OSAL_OK;
+}
+
+uint8_t osal_prio_rank(uint8_t prio)
+{
+    return prio_to_rank(g_osal.cfg.backend, prio);
+}
+
+// Trả về 0 hoặc errno
+static int apply_mapping(pthread_t tid, pid_t ktid, const OSAL_PrioMapping* m)
+{
+    struct sched_param sp;
+    memset(&sp, 0, sizeof(sp));
+
+    if (m->policy != OSAL_PRIO_POLICY_OTHER) {
+        sp.sched_priority = m->value;
+        return pthread_setschedparam(tid, (m->policy == OSAL_PRIO_POLICY_RR) ? SCHED_RR : SCHED_FIFO, &sp);
+    }
+
+    int rc = pthread_setschedparam(tid, SCHED_OTHER, &sp);
+    if (rc != 0) return rc;
+    // nice trên Linux là thuộc tính của từng thread (TID)
+    if (!ktid) {
+        if (!pthread_equal(tid, pthread_self())) return ESRCH;
+        ktid = (pid_t)syscall(SYS_gettid);
+    }
+    if (setpriority(PRIO_PROCESS, (id_t)ktid, m->value) != 0) return errno;
+    return 0;
+}
+
+static const char* policy_name(OSAL_PrioPolicy p)
+{
+    return (p == OSAL_PRIO_POLICY_FIFO) ? "SCHED_FIFO" : (p == OSAL_PRIO_POLICY_RR) ? "SCHED_RR" : "SCHED_OTHER";
+}
+
+int osal_prio_apply(pthread_t tid, pid_t ktid, uint8_t prio, OSAL_PrioMapping* applied)
+{
+    OSAL_PrioMapping m;
+    int rc;
+
+    if (!atomic_load(&g_rt_denied)) {
+        OSAL_PrioResolve(prio, 1, &m);
+        rc = apply_mapping(tid, ktid, &m);
+        if (rc == 0) {
+            OSAL_LOG("[OSAL][Prio] prio=%u -> %s %d ok\r\n", (unsigned)prio, policy_name(m.policy), m.value);
+            if (applied) *applied = m;
+            return 0;
+        }
+        if (rc != EPERM && rc != EACCES) {
+            OSAL_LOG("[OSAL][Prio] prio=%u -> %s %d failed (rc=%d)\r\n",
+                     (unsigned)prio, policy_name(m.policy), m.value, rc);
+            return -1;
+        }
+        // Không có CAP_SYS_NICE: từ đây dùng thẳng bảng fallback, không thử lại syscall thất bại
+        if (!atomic_exchange(&g_rt_denied, 1)) {
+            OSAL_LOG("[OSAL][Prio] no CAP_SYS_NICE, fallback to nice bands\r\n");
+        }
+    }
+
+    OSAL_PrioResolve(prio, 0, &m);
+    rc = apply_mapping(tid, ktid, &m);
+    if (rc != 0) {
+        // Thường gặp khi hạ nice (tăng ưu tiên) mà RLIMIT_NICE không cho phép
+        OSAL_LOG("[OSAL][Prio] prio=%u -> nice %d failed (rc=%d)\r\n", (unsigned)prio, m.value, rc);
+        return -1;
+    }
+    OSAL_LOG("[OSAL][Prio] prio=%u -> nice %d (fallback)\r\n", (unsigned)prio, m.value);
+    if (applied) *applied = m;
+    return 1;
+}
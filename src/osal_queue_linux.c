@@ -0,0 +1,267 @@
+// OSAL message queue cho Linux
+// - Vòng MPMC có giới hạn kiểu Vyukov: mỗi ô có seq; producer giành enq khi seq == 2*pos bằng CAS, chép item,
+//   rồi công bố seq = 2*pos + 1; consumer giành deq khi seq == 2*pos + 1, trả ô bằng seq = 2*(pos + length).
+//   seq nhân đôi để trạng thái "đầy ở pos" và "trống ở pos + 1" không trùng nhau khi length == 1.
+//   pos/seq là uint64_t cả trên target 32 bit: size_t tràn ở 2^32 làm pos % length nhảy ô và seq lệch
+// - Hai vòng: main (Send) và front (SendToFront); Receive thử front trước
+// - Ngủ: put_seq (consumer chờ item) / space_seq của từng vòng (producer chờ chỗ trống) là futex sự kiện;
+//   phía kia fence seq_cst rồi đọc số người ngủ → chỉ syscall khi thật sự có người ngủ.
+//   space_seq tách theo vòng: chỗ trống ở main không đánh thức nhầm người chờ front (và ngược lại)
+
+#include "osal_queue.h"
+#include "osal.h"
+#include "osal_linux_priv.h"
+
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <errno.h>
+
+#ifndef OSAL_QUEUE_NAME_MAX
+#define OSAL_QUEUE_NAME_MAX 16
+#endif
+
+// Vị trí khởi đầu của enq/deq (mặc định 0). Kiểm thử đặt sát 2^32 để đi qua mốc tràn của size_t 32 bit
+#ifndef OSAL_QUEUE_POS_BASE
+#define OSAL_QUEUE_POS_BASE 0u
+#endif
+
+#define OSAL_QUEUE_CACHELINE 64
+
+typedef struct {
+    _Alignas(OSAL_QUEUE_CACHELINE) _Atomic uint64_t enq;
+    _Alignas(OSAL_QUEUE_CACHELINE) _Atomic uint64_t deq;
+    _Alignas(OSAL_QUEUE_CACHELINE) char*            cells;  // [len] × stride: seq (uint64_t) rồi đến item
+    uint64_t                                        len;
+    uint64_t                                        mask;   // len - 1 nếu len là luỹ thừa 2, ngược lại 0
+    _Alignas(OSAL_QUEUE_CACHELINE) _Atomic int      space_seq;   // futex: vòng này có chỗ trống mới
+    _Atomic int                                     space_waiters;
+} QueueRing;
+
+struct OSAL_Queue {
+    QueueRing    main;
+    QueueRing    front;
+    size_t       item_size;
+    size_t       stride;
+    _Alignas(OSAL_QUEUE_CACHELINE) _Atomic int put_seq;     // futex: có item mới
+    _Atomic int  recv_waiters;
+    char         name[OSAL_QUEUE_NAME_MAX];
+};
+
+static inline char* ring_cell(const struct OSAL_Queue* q, const QueueRing* r, uint64_t pos)
+{
+    size_t i = (size_t)(r->mask ? (pos & r->mask) : (pos % r->len));
+    return r->cells + i * q->stride;
+}
+
+static int ring_init(struct OSAL_Queue* q, QueueRing* r, uint32_t len)
+{
+    r->len  = len;
+    r->mask = ((len & (len - 1)) == 0) ? len - 1 : 0;     // len == 1: mask 0 → pos % 1, vẫn đúng
+    r->cells = (char*)aligned_alloc(OSAL_QUEUE_CACHELINE,
+                                    ((size_t)len * q->stride + OSAL_QUEUE_CACHELINE - 1) & ~(size_t)(OSAL_QUEUE_CACHELINE - 1));
+    if (!r->cells) return 0;
+    const uint64_t base = (uint64_t)OSAL_QUEUE_POS_BASE;
+    for (uint64_t pos = base; pos < base + len; ++pos) atomic_init((_Atomic uint64_t*)ring_cell(q, r, pos), 2 * pos);
+    atomic_init(&r->enq, base);
+    atomic_init(&r->deq, base);
+    return 1;
+}
+
+static int ring_push(struct OSAL_Queue* q, QueueRing* r, const void* item)
+{
+    uint64_t pos = atomic_load_explicit(&r->enq, memory_order_relaxed);
+    char* cell;
+    for (;;) {
+        cell = ring_cell(q, r, pos);
+        uint64_t seq = atomic_load_explicit((_Atomic uint64_t*)cell, memory_order_acquire);
+        int64_t dif = (int64_t)(seq - 2 * pos);
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&r->enq, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) break;
+        } else if (dif < 0) {
+            return 0;                                    // đầy
+        } else {
+            pos = atomic_load_explicit(&r->enq, memory_order_relaxed);
+        }
+    }
+    memcpy(cell + sizeof(uint64_t), item, q->item_size);
+    atomic_store_explicit((_Atomic uint64_t*)cell, 2 * pos + 1, memory_order_release);
+    return 1;
+}
+
+static int ring_pop(struct OSAL_Queue* q, QueueRing* r, void* item)
+{
+    uint64_t pos = atomic_load_explicit(&r->deq, memory_order_relaxed);
+    char* cell;
+    for (;;) {
+        cell = ring_cell(q, r, pos);
+        uint64_t seq = atomic_load_explicit((_Atomic uint64_t*)cell, memory_order_acquire);
+        int64_t dif = (int64_t)(seq - (2 * pos + 1));
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&r->deq, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) break;
+        } else if (dif < 0) {
+            return 0;                                    // rỗng
+        } else {
+            pos = atomic_load_explicit(&r->deq, memory_order_relaxed);
+        }
+    }
+    memcpy(item, cell + sizeof(uint64_t), q->item_size);
+    atomic_store_explicit((_Atomic uint64_t*)cell, 2 * (pos + r->len), memory_order_release);
+    return 1;
+}
+
+// Cặp với waiters++ (seq_cst) rồi thử lại phía người ngủ → không mất wakeup
+static inline void queue_signal(_Atomic int* seq, _Atomic int* waiters)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(waiters, memory_order_relaxed)) {
+        atomic_fetch_add(seq, 1);
+        futex_wake(seq, 1);
+    }
+}
+
+static int queue_try_send(struct OSAL_Queue* q, const void* item, int front)
+{
+    if (!ring_push(q, front ? &q->front : &q->main, item)) return 0;
+    queue_signal(&q->put_seq, &q->recv_waiters);
+    return 1;
+}
+
+static int queue_try_recv(struct OSAL_Queue* q, void* item)
+{
+    QueueRing* r = &q->front;
+    if (!(r->len && ring_pop(q, r, item))) {
+        r = &q->main;
+        if (!ring_pop(q, r, item)) return 0;
+    }
+    queue_signal(&r->space_seq, &r->space_waiters);
+    return 1;
+}
+
+static int queue_try(struct OSAL_Queue* q, void* item, int op)
+{
+    return (op < 0) ? queue_try_recv(q, item) : queue_try_send(q, item, op);
+}
+
+// op: -1 Receive, 0 Send, 1 SendToFront
+static OSAL_Status queue_wait(struct OSAL_Queue* q, void* item, int op, uint32_t timeout_ms)
+{
+    if (queue_try(q, item, op)) return OSAL_OK;
+    if (timeout_ms == 0) return OSAL_ETIMEOUT;
+
+    uint64_t deadline = (timeout_ms == OSAL_WAIT_FOREVER) ? 0 : mono_ns() + (uint64_t)timeout_ms * 1000000ull;
+    if (osal_fiber_self()) {
+        uint32_t spin = 0;
+        while (!queue_try(q, item, op)) {
+            if (osal_fiber_backoff(&spin, deadline)) return queue_try(q, item, op) ? OSAL_OK : OSAL_ETIMEOUT;
+        }
+        return OSAL_OK;
+    }
+
+    QueueRing*   r       = (op > 0) ? &q->front : &q->main;
+    _Atomic int* seq     = (op < 0) ? &q->put_seq : &r->space_seq;
+    _Atomic int* waiters = (op < 0) ? &q->recv_waiters : &r->space_waiters;
+    struct timespec dl = { (time_t)(deadline / 1000000000ull), (long)(deadline % 1000000000ull) };
+    OSAL_Status st = OSAL_OK;
+
+    atomic_fetch_add(waiters, 1);
+    for (;;) {
+        int s = atomic_load(seq);
+        if (queue_try(q, item, op)) break;
+        if (futex_wait_abs(seq, s, deadline ? &dl : NULL) != 0 && errno == ETIMEDOUT) {
+            if (!queue_try(q, item, op)) st = OSAL_ETIMEOUT;
+            break;
+        }
+    }
+    atomic_fetch_sub(waiters, 1);
+    return st;
+}
+
+OSAL_Status OSAL_QueueCreate(OSAL_QueueHandle* out, const OSAL_QueueAttr* attr)
+{
+    if (!out || !attr || !attr->length || !attr->item_size) return OSAL_EINVAL;
+    if (attr->length > (uint32_t)INT_MAX || attr->front_length > (uint32_t)INT_MAX) return OSAL_EINVAL;
+
+    struct OSAL_Queue* q = (struct OSAL_Queue*)aligned_alloc(OSAL_QUEUE_CACHELINE, sizeof(*q));
+    if (!q) return OSAL_ENOMEM;
+    memset(q, 0, sizeof(*q));
+    q->item_size = attr->item_size;
+    q->stride    = (sizeof(uint64_t) + attr->item_size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+    if (!ring_init(q, &q->main, attr->length) ||
+        (attr->front_length && !ring_init(q, &q->front, attr->front_length))) {
+        free(q->main.cells);
+        free(q);
+        return OSAL_ENOMEM;
+    }
+    if (attr->name) strncpy(q->name, attr->name, sizeof(q->name) - 1);
+    *out = q;
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_QueueDelete(OSAL_QueueHandle q)
+{
+    if (!q) return OSAL_EINVAL;
+    if (atomic_load(&q->recv_waiters) || atomic_load(&q->main.space_waiters) ||
+        atomic_load(&q->front.space_waiters)) {
+        return OSAL_EBUSY;
+    }
+    free(q->front.cells);
+    free(q->main.cells);
+    free(q);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_QueueSend(OSAL_QueueHandle q, const void* item, uint32_t timeout_ms)
+{
+    if (!q || !item) return OSAL_EINVAL;
+    return queue_wait(q, (void*)item, 0, timeout_ms);
+}
+
+OSAL_Status OSAL_QueueSendToFront(OSAL_QueueHandle q, const void* item, uint32_t timeout_ms)
+{
+    if (!q || !item || !q->front.len) return OSAL_EINVAL;
+    return queue_wait(q, (void*)item, 1, timeout_ms);
+}
+
+OSAL_Status OSAL_QueueReceive(OSAL_QueueHandle q, void* item, uint32_t timeout_ms)
+{
+    if (!q || !item) return OSAL_EINVAL;
+    return queue_wait(q, item, -1, timeout_ms);
+}
+
+OSAL_Status OSAL_QueueTrySend(OSAL_QueueHandle q, const void* item)
+{
+    if (!q || !item) return OSAL_EINVAL;
+    return queue_try_send(q, item, 0) ? OSAL_OK : OSAL_EBUSY;
+}
+
+OSAL_Status OSAL_QueueTrySendToFront(OSAL_QueueHandle q, const void* item)
+{
+    if (!q || !item || !q->front.len) return OSAL_EINVAL;
+    return queue_try_send(q, item, 1) ? OSAL_OK : OSAL_EBUSY;
+}
+
+OSAL_Status OSAL_QueueTryReceive(OSAL_QueueHandle q, void* item)
+{
+    if (!q || !item) return OSAL_EINVAL;
+    return queue_try_recv(q, item) ? OSAL_OK : OSAL_EBUSY;
+}
+
+static uint64_t ring_count(const QueueRing* r)
+{
+    if (!r->len) return 0;
+    uint64_t d = atomic_load(&r->deq);
+    uint64_t e = atomic_load(&r->enq);
+    uint64_t n = (e > d) ? e - d : 0;
+    return (n > r->len) ? r->len : n;
+}
+
+OSAL_Status OSAL_QueueGetCount(OSAL_QueueHandle q, uint32_t* count)
+{
+    if (!q || !count) return OSAL_EINVAL;
+    *count = (uint32_t)(ring_count(&q->main) + ring_count(&q->front));
+    return OSAL_OK;
+}
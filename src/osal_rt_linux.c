@@ -0,0 +1,109 @@
+// OSAL profile khởi động real-time cho Linux
+// - Mục tiêu: mọi page fault xảy ra trong OSAL_Init, không phải trong vòng lặp RT vài giây đầu
+// - Thứ tự: tắt trim/mmap của malloc → mlockall → prefault heap → prefault stack thread hiện tại
+// - Chỉ kiểm tra (không sửa) cấu hình kernel: RT throttling là chính sách của hệ thống
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "osal_linux_priv.h"
+#include "osal.h"
+
+#include <errno.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// Phần stack của thread gọi OSAL_Init được chạm trước
+#ifndef OSAL_RT_MAIN_STACK_DEFAULT
+#define OSAL_RT_MAIN_STACK_DEFAULT (256u * 1024u)
+#endif
+
+// Stack của task không chỉ định stack_size khi profile RT bật
+#ifndef OSAL_RT_TASK_STACK_DEFAULT
+#define OSAL_RT_TASK_STACK_DEFAULT (256u * 1024u)
+#endif
+
+static size_t g_rt_task_stack = 0;
+
+size_t osal_rt_task_stack(void)
+{
+    return g_rt_task_stack;
+}
+
+static long read_long_file(const char* path, long def)
+{
+    char buf[32];
+    FILE* f = fopen(path, "r");
+    if (!f) return def;
+    long v = def;
+    if (fgets(buf, sizeof(buf), f)) v = strtol(buf, NULL, 10);
+    fclose(f);
+    return v;
+}
+
+// Chạm từng trang của một vùng heap rồi trả về malloc (trim đã tắt → trang vẫn thuộc process)
+static void prefault_heap(size_t bytes)
+{
+    long pg = sysconf(_SC_PAGESIZE);
+    if (pg <= 0) pg = 4096;
+    char* p = (char*)malloc(bytes);
+    if (!p) {
+        OSAL_LOG("[OSAL][RT] heap prefault %zu bytes failed\r\n", bytes);
+        return;
+    }
+    for (size_t off = 0; off < bytes; off += (size_t)pg) {
+        ((volatile char*)p)[off] = 0;
+    }
+    free(p);
+}
+
+// Chạm trước phần stack sâu hơn frame hiện tại (noinline: mảng nằm dưới frame người gọi)
+static __attribute__((noinline)) void prefault_stack(size_t bytes)
+{
+    long pg = sysconf(_SC_PAGESIZE);
+    if (pg <= 0) pg = 4096;
+    volatile char* p = (volatile char*)__builtin_alloca(bytes);
+    for (size_t off = 0; off < bytes; off += (size_t)pg) {
+        p[off] = 0;
+    }
+}
+
+static void check_rt_throttling(void)
+{
+    long runtime = read_long_file("/proc/sys/kernel/sched_rt_runtime_us", -1);
+    long period  = read_long_file("/proc/sys/kernel/sched_rt_period_us", 0);
+    if (runtime >= 0 && period > 0) {
+        // Task FIFO/RR bị dừng cưỡng bức (period - runtime) us mỗi period khi chiếm hết CPU
+        OSAL_LOG("[OSAL][RT] warning: RT throttling active (%ld/%ld us), "
+                 "write -1 to /proc/sys/kernel/sched_rt_runtime_us to disable\r\n", runtime, period);
+    }
+}
+
+void osal_rt_apply(void)
+{
+    const OSAL_RtProfile* rt = &g_osal.cfg.rt;
+
+    // Heap không trả trang về kernel và không cấp block lớn bằng mmap riêng (mmap mới = fault mới)
+    if (!mallopt(M_TRIM_THRESHOLD, -1) || !mallopt(M_MMAP_MAX, 0)) {
+        OSAL_LOG("[OSAL][RT] mallopt failed\r\n");
+    }
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        OSAL_LOG("[OSAL][RT] mlockall failed (errno=%d), memory may still page fault\r\n", errno);
+    }
+
+    if (rt->heap_reserve) prefault_heap(rt->heap_reserve);
+    prefault_stack(rt->main_stack ? rt->main_stack : OSAL_RT_MAIN_STACK_DEFAULT);
+
+    g_rt_task_stack = rt->task_stack ? rt->task_stack : OSAL_RT_TASK_STACK_DEFAULT;
+    check_rt_throttling();
+
+    OSAL_LOG("[OSAL][RT] profile on: heap=%zu main_stack=%zu task_stack=%zu\r\n",
+             rt->heap_reserve, rt->main_stack ? rt->main_stack : (size_t)OSAL_RT_MAIN_STACK_DEFAULT,
+             g_rt_task_stack);
+}
@@ -0,0 +1,128 @@
+// OSAL semaphore cho Linux
+// - count là futex word: Take = CAS count → count-1 khi > 0, Give = fetch_add (+ CAS khi có max)
+// - waiters đếm người đang (sắp) ngủ trên futex → Give không tranh chấp không syscall
+// - Thứ tự waiters++ → kiểm tra count (bên chờ) và count++ → đọc waiters (bên Give) đều seq_cst:
+//   ít nhất một bên thấy bên kia → không mất lần đánh thức
+
+#include "osal_sem.h"
+#include "osal.h"
+#include "osal_linux_priv.h"
+
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <errno.h>
+
+#ifndef OSAL_SEM_NAME_MAX
+#define OSAL_SEM_NAME_MAX 16
+#endif
+
+struct OSAL_Sem {
+    _Atomic int  count;     // futex
+    _Atomic int  waiters;
+    int          max;
+    char         name[OSAL_SEM_NAME_MAX];
+};
+
+static inline int sem_try_take(struct OSAL_Sem* s)
+{
+    int c = atomic_load_explicit(&s->count, memory_order_relaxed);
+    while (c > 0) {
+        if (atomic_compare_exchange_weak_explicit(&s->count, &c, c - 1,
+                                                  memory_order_acquire, memory_order_relaxed)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+OSAL_Status OSAL_SemCreate(OSAL_SemHandle* out, const OSAL_SemAttr* attr)
+{
+    if (!out || !attr) return OSAL_EINVAL;
+    uint32_t max = attr->max ? attr->max : (uint32_t)INT_MAX;
+    if (max > (uint32_t)INT_MAX || attr->initial > max) return OSAL_EINVAL;
+
+    struct OSAL_Sem* s = (struct OSAL_Sem*)calloc(1, sizeof(*s));
+    if (!s) return OSAL_ENOMEM;
+    atomic_init(&s->count, (int)attr->initial);
+    atomic_init(&s->waiters, 0);
+    s->max = (int)max;
+    if (attr->name) strncpy(s->name, attr->name, sizeof(s->name) - 1);
+    *out = s;
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_SemDelete(OSAL_SemHandle s)
+{
+    if (!s) return OSAL_EINVAL;
+    if (atomic_load(&s->waiters)) return OSAL_EBUSY;
+    free(s);
+    return OSAL_OK;
+}
+
+// Async-signal-safe: chỉ atomic + futex_wake
+OSAL_Status OSAL_SemGive(OSAL_SemHandle s)
+{
+    if (!s) return OSAL_EINVAL;
+    if (s->max == INT_MAX) {
+        // Không giới hạn (thực tế): một fetch_add
+        if (atomic_fetch_add(&s->count, 1) == INT_MAX) {
+            atomic_fetch_sub(&s->count, 1);
+            return OSAL_EBUSY;
+        }
+    } else {
+        int c = atomic_load_explicit(&s->count, memory_order_relaxed);
+        do {
+            if (c >= s->max) return OSAL_EBUSY;
+        } while (!atomic_compare_exchange_weak(&s->count, &c, c + 1));
+    }
+    if (atomic_load(&s->waiters)) futex_wake(&s->count, 1);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_SemGiveFromSignal(OSAL_SemHandle s)
+{
+    return OSAL_SemGive(s);
+}
+
+OSAL_Status OSAL_SemTake(OSAL_SemHandle s, uint32_t timeout_ms)
+{
+    if (!s) return OSAL_EINVAL;
+    if (sem_try_take(s)) return OSAL_OK;
+    if (timeout_ms == 0) return OSAL_ETIMEOUT;
+
+    if (osal_fiber_self()) {
+        uint64_t deadline = (timeout_ms == OSAL_WAIT_FOREVER) ? 0 : mono_ns() + (uint64_t)timeout_ms * 1000000ull;
+        uint32_t spin = 0;
+        while (!sem_try_take(s)) {
+            if (osal_fiber_backoff(&spin, deadline)) return sem_try_take(s) ? OSAL_OK : OSAL_ETIMEOUT;
+        }
+        return OSAL_OK;
+    }
+
+    struct timespec dl;
+    if (timeout_ms != OSAL_WAIT_FOREVER) {
+        clock_gettime(CLOCK_MONOTONIC, &dl);
+        timespec_add_ms(&dl, timeout_ms);
+    }
+
+    OSAL_Status st = OSAL_OK;
+    atomic_fetch_add(&s->waiters, 1);
+    while (!sem_try_take(s)) {
+        if (futex_wait_abs(&s->count, 0, (timeout_ms == OSAL_WAIT_FOREVER) ? NULL : &dl) != 0 &&
+            errno == ETIMEDOUT) {
+            if (!sem_try_take(s)) st = OSAL_ETIMEOUT;
+            break;
+        }
+    }
+    atomic_fetch_sub(&s->waiters, 1);
+    return st;
+}
+
+OSAL_Status OSAL_SemGetCount(OSAL_SemHandle s, uint32_t* count)
+{
+    if (!s || !count) return OSAL_EINVAL;
+    *count = (uint32_t)atomic_load(&s->count);
+    return OSAL_OK;
+}
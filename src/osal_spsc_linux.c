@@ -0,0 +1,207 @@
+// OSAL kênh SPSC cho Linux
+// - tail chỉ producer ghi, head chỉ consumer ghi (số đếm tăng mãi, ô = index & mask trên vòng luỹ thừa 2
+//   >= length; số item = tail - head <= length)
+// - Mỗi phía giữ bản cache chỉ số phía kia trên line của mình → đường nóng không chạm line phía kia
+// - Chờ: người chờ ghi ngưỡng (want) rồi kiểm tra lại, phía kia fence seq_cst rồi đọc want →
+//   chỉ futex_wake khi có người chờ và ngưỡng đã đạt
+
+#include "osal_spsc.h"
+#include "osal.h"
+#include "osal_linux_priv.h"
+
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <errno.h>
+
+#ifndef OSAL_SPSC_NAME_MAX
+#define OSAL_SPSC_NAME_MAX 16
+#endif
+
+#define OSAL_SPSC_CACHELINE 64
+
+struct OSAL_Spsc {
+    // Phía producer
+    _Alignas(OSAL_SPSC_CACHELINE) _Atomic size_t tail;
+    size_t       head_cache;
+    // Phía consumer
+    _Alignas(OSAL_SPSC_CACHELINE) _Atomic size_t head;
+    size_t       tail_cache;
+    // Chờ
+    _Alignas(OSAL_SPSC_CACHELINE) _Atomic int data_seq;    // futex: consumer chờ dữ liệu
+    _Atomic int  data_want;                                 // ngưỡng item consumer chờ (0 = không chờ)
+    _Alignas(OSAL_SPSC_CACHELINE) _Atomic int space_seq;   // futex: producer chờ chỗ trống
+    _Atomic int  space_want;
+    // Chỉ đọc
+    _Alignas(OSAL_SPSC_CACHELINE) char* buf;
+    size_t       length;
+    size_t       mask;
+    size_t       item_size;
+    char         name[OSAL_SPSC_NAME_MAX];
+};
+
+// Chép n item bắt đầu ở index pos (vòng) ↔ mem; tối đa hai đoạn
+static inline void spsc_copy(struct OSAL_Spsc* ch, size_t pos, void* mem, size_t n, int to_ring)
+{
+    size_t i     = pos & ch->mask;
+    size_t first = ch->mask + 1 - i;
+    if (first > n) first = n;
+    char* ring = ch->buf + i * ch->item_size;
+    char* m    = (char*)mem;
+    if (to_ring) {
+        memcpy(ring, m, first * ch->item_size);
+        memcpy(ch->buf, m + first * ch->item_size, (n - first) * ch->item_size);
+    } else {
+        memcpy(m, ring, first * ch->item_size);
+        memcpy(m + first * ch->item_size, ch->buf, (n - first) * ch->item_size);
+    }
+}
+
+static inline size_t spsc_data(struct OSAL_Spsc* ch)
+{
+    return atomic_load_explicit(&ch->tail, memory_order_acquire) -
+           atomic_load_explicit(&ch->head, memory_order_relaxed);
+}
+
+static inline size_t spsc_space(struct OSAL_Spsc* ch)
+{
+    return ch->length - (atomic_load_explicit(&ch->tail, memory_order_relaxed) -
+                         atomic_load_explicit(&ch->head, memory_order_acquire));
+}
+
+// Đánh thức phía kia nếu nó đang chờ và đã đạt ngưỡng của nó; không có người chờ thì không đọc line phía kia
+static inline void spsc_signal(struct OSAL_Spsc* ch, int data)
+{
+    _Atomic int* want = data ? &ch->data_want : &ch->space_want;
+    atomic_thread_fence(memory_order_seq_cst);
+    int w = atomic_load_explicit(want, memory_order_relaxed);
+    if (w && (data ? spsc_data(ch) : spsc_space(ch)) >= (size_t)w) {
+        _Atomic int* seq = data ? &ch->data_seq : &ch->space_seq;
+        atomic_fetch_add(seq, 1);
+        futex_wake(seq, 1);
+    }
+}
+
+OSAL_Status OSAL_SpscCreate(OSAL_SpscHandle* out, const OSAL_SpscAttr* attr)
+{
+    if (!out || !attr || !attr->length || !attr->item_size || attr->length > (uint32_t)INT_MAX) return OSAL_EINVAL;
+
+    size_t cap = 1;
+    while (cap < attr->length) cap <<= 1;
+
+    struct OSAL_Spsc* ch = (struct OSAL_Spsc*)aligned_alloc(OSAL_SPSC_CACHELINE, sizeof(*ch));
+    if (!ch) return OSAL_ENOMEM;
+    memset(ch, 0, sizeof(*ch));
+    ch->buf = (char*)malloc(cap * attr->item_size);
+    if (!ch->buf) {
+        free(ch);
+        return OSAL_ENOMEM;
+    }
+    ch->length    = attr->length;
+    ch->mask      = cap - 1;
+    ch->item_size = attr->item_size;
+    if (attr->name) strncpy(ch->name, attr->name, sizeof(ch->name) - 1);
+    *out = ch;
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_SpscDelete(OSAL_SpscHandle ch)
+{
+    if (!ch) return OSAL_EINVAL;
+    if (atomic_load(&ch->data_want) || atomic_load(&ch->space_want)) return OSAL_EBUSY;
+    free(ch->buf);
+    free(ch);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_SpscPush(OSAL_SpscHandle ch, const void* items, uint32_t n, uint32_t* pushed)
+{
+    if (!ch || (!items && n)) return OSAL_EINVAL;
+    size_t tail = atomic_load_explicit(&ch->tail, memory_order_relaxed);
+    size_t free_n = ch->length - (tail - ch->head_cache);
+    if (free_n < n) {
+        ch->head_cache = atomic_load_explicit(&ch->head, memory_order_acquire);
+        free_n = ch->length - (tail - ch->head_cache);
+    }
+    size_t k = (n < free_n) ? n : free_n;
+    if (k) {
+        spsc_copy(ch, tail, (void*)items, k, 1);
+        atomic_store_explicit(&ch->tail, tail + k, memory_order_release);
+        spsc_signal(ch, 1);
+    }
+    if (pushed) *pushed = (uint32_t)k;
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_SpscPop(OSAL_SpscHandle ch, void* items, uint32_t max, uint32_t* popped)
+{
+    if (!ch || (!items && max)) return OSAL_EINVAL;
+    size_t head = atomic_load_explicit(&ch->head, memory_order_relaxed);
+    size_t avail = ch->tail_cache - head;
+    if (avail < max) {
+        ch->tail_cache = atomic_load_explicit(&ch->tail, memory_order_acquire);
+        avail = ch->tail_cache - head;
+    }
+    size_t k = (max < avail) ? max : avail;
+    if (k) {
+        spsc_copy(ch, head, items, k, 0);
+        atomic_store_explicit(&ch->head, head + k, memory_order_release);
+        spsc_signal(ch, 0);
+    }
+    if (popped) *popped = (uint32_t)k;
+    return OSAL_OK;
+}
+
+static OSAL_Status spsc_wait(struct OSAL_Spsc* ch, uint32_t n, uint32_t timeout_ms, int data)
+{
+    if (!ch || !n || n > ch->length) return OSAL_EINVAL;
+    size_t (*avail)(struct OSAL_Spsc*) = data ? spsc_data : spsc_space;
+    if (avail(ch) >= n) return OSAL_OK;
+    if (timeout_ms == 0) return OSAL_ETIMEOUT;
+
+    uint64_t deadline = (timeout_ms == OSAL_WAIT_FOREVER) ? 0 : mono_ns() + (uint64_t)timeout_ms * 1000000ull;
+    if (osal_fiber_self()) {
+        uint32_t spin = 0;
+        while (avail(ch) < n) {
+            if (osal_fiber_backoff(&spin, deadline)) return (avail(ch) >= n) ? OSAL_OK : OSAL_ETIMEOUT;
+        }
+        return OSAL_OK;
+    }
+
+    _Atomic int* seq  = data ? &ch->data_seq : &ch->space_seq;
+    _Atomic int* want = data ? &ch->data_want : &ch->space_want;
+    struct timespec dl = { (time_t)(deadline / 1000000000ull), (long)(deadline % 1000000000ull) };
+    OSAL_Status st = OSAL_OK;
+
+    atomic_store(want, (int)n);
+    atomic_thread_fence(memory_order_seq_cst);      // cặp với fence trong spsc_signal
+    for (;;) {
+        int s = atomic_load(seq);
+        if (avail(ch) >= n) break;
+        if (futex_wait_abs(seq, s, deadline ? &dl : NULL) != 0 && errno == ETIMEDOUT) {
+            if (avail(ch) < n) st = OSAL_ETIMEOUT;
+            break;
+        }
+    }
+    atomic_store(want, 0);
+    return st;
+}
+
+OSAL_Status OSAL_SpscWaitData(OSAL_SpscHandle ch, uint32_t n, uint32_t timeout_ms)
+{
+    return spsc_wait(ch, n, timeout_ms, 1);
+}
+
+OSAL_Status OSAL_SpscWaitSpace(OSAL_SpscHandle ch, uint32_t n, uint32_t timeout_ms)
+{
+    return spsc_wait(ch, n, timeout_ms, 0);
+}
+
+OSAL_Status OSAL_SpscGetCount(OSAL_SpscHandle ch, uint32_t* count)
+{
+    if (!ch || !count) return OSAL_EINVAL;
+    size_t n = spsc_data(ch);
+    *count = (uint32_t)((n > ch->length) ? ch->length : n);
+    return OSAL_OK;
+}
@@ -0,0 +1,194 @@
+// OSAL stack provider cho Linux
+// - Một vùng pool được reserve (PROT_NONE) một lần, stack được cắt dần theo nhu cầu
+// - Mỗi stack: [guard PROT_NONE][stack RW đã prefault] → tràn stack là SIGSEGV, không ghi đè stack khác
+// - Stack trả về được tái sử dụng (best-fit); pool hết → mmap riêng với cùng layout
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "osal_linux_priv.h"
+#include "osal.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// Dung lượng vùng pool (chỉ reserve địa chỉ; RAM chỉ tốn cho stack thực sự được cắt)
+#ifndef OSAL_STACK_POOL_BYTES
+#define OSAL_STACK_POOL_BYTES (16u * 1024u * 1024u)
+#endif
+
+// Số trang guard dưới mỗi stack
+#ifndef OSAL_STACK_GUARD_PAGES
+#define OSAL_STACK_GUARD_PAGES 1u
+#endif
+
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+typedef struct FreeBlock {
+    struct FreeBlock* next;
+    char*             map;        // đầu block (guard)
+    size_t            map_size;   // guard + stack
+} FreeBlock;
+
+static pthread_mutex_t g_stk_mtx   = PTHREAD_MUTEX_INITIALIZER;
+static char*           g_pool      = NULL;
+static size_t          g_pool_used = 0;      // bump pointer
+static FreeBlock*      g_free      = NULL;   // block đã trả về (metadata nằm trong heap)
+static size_t          g_page      = 0;
+
+static size_t page_size(void)
+{
+    if (!g_page) {
+        long p = sysconf(_SC_PAGESIZE);
+        g_page = (p > 0) ? (size_t)p : 4096u;
+    }
+    return g_page;
+}
+
+static inline size_t round_up(size_t v, size_t a)
+{
+    return (v + a - 1) / a * a;
+}
+
+// Ghi trước mọi trang → không page fault khi task đi sâu stack lần đầu
+static void prefault(char* p, size_t n)
+{
+    if (madvise(p, n, MADV_POPULATE_WRITE) == 0) return;
+    // Kernel < 5.14: chạm tay từng trang
+    size_t pg = page_size();
+    for (size_t off = 0; off < n; off += pg) {
+        ((volatile char*)p)[off] = 0;
+    }
+}
+
+size_t osal_stack_round(size_t size)
+{
+    long  m   = sysconf(_SC_THREAD_STACK_MIN);
+    size_t mn = (m > 0) ? (size_t)m : (size_t)PTHREAD_STACK_MIN;
+    if (size < mn) size = mn;
+    return round_up(size, page_size());
+}
+
+static int pool_reserve(void)
+{
+    if (g_pool) return 1;
+    void* p = mmap(NULL, OSAL_STACK_POOL_BYTES, PROT_NONE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+        OSAL_LOG("[OSAL][Stack] reserve pool %u bytes failed (errno=%d)\r\n",
+                 (unsigned)OSAL_STACK_POOL_BYTES, errno);
+        return 0;
+    }
+    g_pool = (char*)p;
+    return 1;
+}
+
+// Mở quyền RW cho phần stack (guard giữ PROT_NONE) và prefault
+static int commit_block(char* map, size_t map_size, size_t guard)
+{
+    if (mprotect(map + guard, map_size - guard, PROT_READ | PROT_WRITE) != 0) return 0;
+    prefault(map + guard, map_size - guard);
+    return 1;
+}
+
+// stk đã làm tròn trang
+static int stack_alloc_block(size_t stk, OsalStack* out)
+{
+    size_t guard = OSAL_STACK_GUARD_PAGES * page_size();
+    size_t need  = guard + stk;
+
+    memset(out, 0, sizeof(*out));
+    pthread_mutex_lock(&g_stk_mtx);
+
+    // 1) Best-fit trong các block đã trả về (block vẫn RW + đã fault sẵn)
+    FreeBlock** best = NULL;
+    for (FreeBlock** pp = &g_free; *pp; pp = &(*pp)->next) {
+        if ((*pp)->map_size >= need && (!best || (*pp)->map_size < (*best)->map_size)) {
+            best = pp;
+            if ((*pp)->map_size == need) break;
+        }
+    }
+    if (best) {
+        FreeBlock* b = *best;
+        *best = b->next;
+        pthread_mutex_unlock(&g_stk_mtx);
+        out->map      = b->map;
+        out->map_size = b->map_size;
+        out->pooled   = 1;
+        free(b);
+        goto done;
+    }
+
+    // 2) Cắt tiếp từ pool
+    if (pool_reserve() && g_pool_used + need <= OSAL_STACK_POOL_BYTES) {
+        char* map = g_pool + g_pool_used;
+        if (commit_block(map, need, guard)) {
+            g_pool_used += need;
+            pthread_mutex_unlock(&g_stk_mtx);
+            out->map      = map;
+            out->map_size = need;
+            out->pooled   = 1;
+            goto done;
+        }
+    }
+    pthread_mutex_unlock(&g_stk_mtx);
+
+    // 3) Pool hết → mmap riêng, cùng layout guard + prefault
+    {
+        void* p = mmap(NULL, need, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+        if (p == MAP_FAILED) return errno;
+        if (!commit_block((char*)p, need, guard)) {
+            int err = errno;
+            munmap(p, need);
+            return err;
+        }
+        out->map      = (char*)p;
+        out->map_size = need;
+        out->pooled   = 0;
+    }
+
+done:
+    out->base = out->map + guard;
+    out->size = out->map_size - guard;
+    return 0;
+}
+
+int osal_stack_alloc(size_t size, OsalStack* out)
+{
+    if (!out) return EINVAL;
+    return stack_alloc_block(osal_stack_round(size), out);
+}
+
+int osal_stack_alloc_small(size_t size, OsalStack* out)
+{
+    if (!out || !size) return EINVAL;
+    return stack_alloc_block(round_up(size, page_size()), out);
+}
+
+void osal_stack_free(OsalStack* st)
+{
+    if (!st || !st->map) return;
+    if (!st->pooled) {
+        munmap(st->map, st->map_size);
+    } else {
+        FreeBlock* b = (FreeBlock*)malloc(sizeof(*b));
+        if (b) {
+            b->map      = st->map;
+            b->map_size = st->map_size;
+            pthread_mutex_lock(&g_stk_mtx);
+            b->next = g_free;
+            g_free  = b;
+            pthread_mutex_unlock(&g_stk_mtx);
+        }
+        // malloc lỗi → block bị "rò" trong pool, không ảnh hưởng an toàn
+    }
+    memset(st, 0, sizeof(*st));
+}
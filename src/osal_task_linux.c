@@ -1,10 +1,31 @@
 // OSAL task backend for Linux (pthread + cooperative suspend/stop + RT prio)
 // - Suspend/Resume: cooperative via condvar (có hiệu lực khi task gọi OSAL_TaskDelayMs / OSAL_TaskYield)
-// - Stop/Delete   : cooperative stop (flag + join) => an toàn tài nguyên
-// - Priority      : SCHED_FIFO nếu có CAP_SYS_NICE, fallback SCHED_OTHER
+//                   hoặc preemptive (OSAL_TASK_F_PREEMPT_SUSPEND): RT signal, handler đỗ thread trên futex
+// - Delay         : một lần chờ timed trên deadline tuyệt đối CLOCK_MONOTONIC, Suspend/Resume/Delete đánh thức trực tiếp
+// - Stop/Delete   : cooperative stop (flag + chờ thread nhả task) => an toàn tài nguyên
+// - Thread cache  : entry trả về → thread đỗ lại trong cache, Create sau gắn task mới vào (không pthread_create)
+// - Priority      : qua priority domain (osal_prio_linux.c): FIFO/RR/nice theo band, fallback nice giữ thứ tự
+//                   hoặc SCHED_DEADLINE (runtime/deadline/period trong attr, admission control của kernel)
+// - Registry      : bảng task tăng dần theo chunk, free-list lock-free, handle = (generation, index)
+// - Snapshot      : mỗi slot có bản công bố (handle/name/prio/mask) dưới seqlock → ForEach/Count/Snapshot
+//                   không khoá, chỉ thấy task đã Create xong, không bao giờ thấy bản ghi dở dang
+// - Stack         : cấp từ stack provider (guard page + prefault), kích thước nhỏ được giữ nguyên
+// - Affinity      : cpu_mask đặt qua pthread_attr trước khi thread chạy, tự chọn core isolcpus/nohz_full
+// - Notify        : giá trị notify + futex trong LinuxTask (kiểu xTaskNotify), đường Notify không khoá
+// - Local storage : OSAL_TASK_LOCAL_SLOTS con trỏ trong LinuxTask, task hiện tại truy cập qua TLS
+// - Batch create  : OSAL_TaskCreateBatch tạo song song, task đứng ở cổng (gated) đến mốc thả chung
+// - Join/Detach   : entry trả về / OSAL_TaskExit → COMPLETED giữ exit status đến khi Join; task detached tự dọn
+//                   futex g_exit_seq báo "có task vừa kết thúc" cho OSAL_TaskWaitAny
+// - Fiber         : OSAL_TASK_F_FIBER → task chạy trên carrier thread (osal_fiber_linux.c),
+//                   Delay/Yield/Suspend/Resume là điểm chuyển user-space
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE     // pthread_setname_np, cpu_set_t, pthread_*affinity_np
+#endif
 
 #include "osal_task.h"
 #include "osal.h"
+#include "osal_linux_priv.h"
 
 #include <pthread.h>
 #include <sched.h>
@@ -13,317 +34,2075 @@
 #include <time.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
 #include <errno.h>
+#include <stdio.h>
+#include <limits.h>
+#include <sys/types.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
+// Trần số task (registry cấp phát dần theo chunk, không cấp sẵn toàn bộ)
 #ifndef OSAL_MAX_TASKS
-#define OSAL_MAX_TASKS 8
+#define OSAL_MAX_TASKS 16384
+#endif
+
+#ifndef OSAL_TASK_CHUNK
+#define OSAL_TASK_CHUNK 32
+#endif
+
+#define OSAL_TASK_NCHUNKS    ((OSAL_MAX_TASKS + OSAL_TASK_CHUNK - 1) / OSAL_TASK_CHUNK)
+
+// Handle = (generation << 16) | (index + 1) → không bao giờ 0, handle cũ bị phát hiện qua generation.
+// Handle 64 bit, generation 32 bit đầy đủ: slot LIFO quay vòng 2^31 lần mới trùng (16 bit trên ARM 32 bit
+// chỉ cần 32768 vòng Create/Delete)
+#define OSAL_HANDLE_IDX_BITS 16u
+#define OSAL_HANDLE_IDX_MASK ((1u << OSAL_HANDLE_IDX_BITS) - 1u)
+
+_Static_assert(OSAL_MAX_TASKS < (1u << OSAL_HANDLE_IDX_BITS), "OSAL_MAX_TASKS vượt quá số bit index của handle");
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
+// Signal dùng cho preemptive suspend
+#ifndef OSAL_SUSPEND_SIGNAL
+#define OSAL_SUSPEND_SIGNAL (SIGRTMIN + 3)
+#endif
+
+// Thời gian tối đa OSAL_TaskSuspend chờ task xác nhận đã đỗ (preemptive)
+#ifndef OSAL_SUSPEND_ACK_MS
+#define OSAL_SUSPEND_ACK_MS 10
+#endif
+
+// Stack mặc định của task fiber (stack_size = 0)
+#ifndef OSAL_FIBER_STACK_DEFAULT
+#define OSAL_FIBER_STACK_DEFAULT 8192u
+#endif
+
+// CreateBatch: số thread phụ tối đa, và số task mỗi thread phụ phải gánh mới đáng tạo thêm
+#ifndef OSAL_TASK_BATCH_HELPERS
+#define OSAL_TASK_BATCH_HELPERS 4
+#endif
+#ifndef OSAL_TASK_BATCH_PER_HELPER
+#define OSAL_TASK_BATCH_PER_HELPER 8
+#endif
+
+// Số thread rảnh tối đa được giữ lại để tái sử dụng
+#ifndef OSAL_THREAD_CACHE_MAX
+#define OSAL_THREAD_CACHE_MAX 16
 #endif
 
 #ifndef OSAL_TASK_NAME_MAX
 #define OSAL_TASK_NAME_MAX 16
 #endif
 
+// Số lần đọc lại seqlock trước khi Snapshot lấy khoá của người ghi (t->mtx): reader RT chung CPU với
+// người ghi SCHED_OTHER bị preempt giữa chừng thì sched_yield không bao giờ nhường CPU cho người ghi
+#ifndef OSAL_TASK_PUB_SPIN
+#define OSAL_TASK_PUB_SPIN 64u
+#endif
+
+struct LinuxThread;
+
+#define OSAL_TASK_PUB_WORDS ((OSAL_TASK_NAME_MAX + 7) / 8)
+
+// Bản công bố của task cho người đọc không khoá (seqlock một người ghi: chủ t->mtx)
+typedef struct {
+    _Atomic uint32_t  seq;         // lẻ: đang ghi
+    _Atomic uint64_t  handle;      // 0: slot chưa công bố (đang Create / đã dọn)
+    _Atomic uint64_t  name[OSAL_TASK_PUB_WORDS];
+    _Atomic uint32_t  cpu_mask;
+    _Atomic uint32_t  flags;
+    _Atomic uint8_t   prio;
+} TaskPub;
+
+// Bộ đếm kernel của thread tại lúc gắn task: thread tái sử dụng còn mang số liệu của các task trước
+typedef struct {
+    uint64_t cpu_ns;
+    uint64_t runq_ns;
+    uint32_t vcsw;
+    uint32_t ivcsw;
+} TaskStatsBase;
+
 typedef struct LinuxTask {
-    uint8_t           used;
-    pthread_t         tid;
+    // --- Cố định suốt đời slot (không bị xoá khi slot được tái sử dụng) ---
     pthread_mutex_t   mtx;
     pthread_cond_t    cv;
+    _Atomic uint32_t  gen;         // lẻ: đang dùng, chẵn: rảnh
+    uint32_t          idx;         // vị trí trong registry
+    _Atomic uint32_t  next_free;   // index+1 của slot kế tiếp trong free-list (0 = hết)
+    _Atomic int       notify_refs; // futex: số Notify đang chạm slot | NOTIFY_REF_DRAIN khi slot đang được dọn
+    TaskPub           pub;
+    // --- Trạng thái task (xoá về 0 mỗi lần cấp phát) ---
+    uint8_t           deleting;    // đã có người gọi Delete (chặn join 2 lần)
+    pthread_t         tid;
+    pid_t             ktid;        // TID kernel (cho /proc, setpriority...), 0 khi thread chưa chạy
+    struct LinuxThread* thr;       // thread đang chạy task
+    OsalFiber*        fib;         // != NULL → task fiber (thr = NULL, tid = carrier)
+    uint8_t           thr_done;    // thread đã nhả task (không còn chạm vào slot)
+    uint8_t           thr_exit;    // thread đã/đang thoát → người dọn phải join (không về cache)
+    uint8_t           thr_leaving; // entry đã trả về, thread đang reset lập lịch → ChangePrio không chạm nữa
+    uint8_t           detached;    // OSAL_TaskDetach: bên nhả task tự dọn slot, không Join/Delete được nữa
+    int32_t           exit_status; // OSAL_TaskExit (entry trả về → 0)
     volatile int      running;     // 1: đang chạy, 0: yêu cầu dừng (stop/delete)
     volatile int      suspended;   // 1: yêu cầu tạm dừng (cooperative)
+    uint8_t           preempt;     // OSAL_TASK_F_PREEMPT_SUSPEND
+    uint8_t           blocked;     // TASK_BLK_*: task đang chờ gì (để GetState báo đúng)
+    _Atomic int       park_req;    // futex: 1 = phải đỗ (preemptive suspend)
+    _Atomic int       park_state;  // futex: 1 = đang đỗ (handler hoặc chờ suspend cooperative)
     char              name[OSAL_TASK_NAME_MAX];
-    uint8_t           prio_req;    // prio yêu cầu (0..255)
+    uint8_t           prio_req;    // prio yêu cầu (0..255, quy ước theo backend)
+    uint8_t           prio_set;    // 1: có attr → áp dụng prio_req khi start
+    uint32_t          cpu_mask;    // affinity hiện tại (0 = mọi CPU)
+    uint32_t          dl_runtime_us;   // != 0 → SCHED_DEADLINE
+    uint32_t          dl_deadline_us;
+    uint32_t          dl_period_us;
+    uint8_t           start_done;  // trampoline đã áp dụng xong tham số lập lịch
+    uint8_t           batch;       // tạo bởi CreateBatch (không đổi suốt đời task)
+    uint8_t           gated;       // batch: còn đứng ở cổng trước entry, xoá khi được thả
+    uint64_t          gate_ns;     // mốc thả (CLOCK_MONOTONIC ns, 0 = ngay)
+    int               start_err;   // errno khi áp dụng SCHED_DEADLINE thất bại
+    uint8_t           iso_cpu;     // CPU isolated đã tự chọn + 1 (0 = không)
     OSAL_TaskEntry    entry;
     void*             arg;
+    // Thống kê chu kỳ cho OSAL_TaskDelayUntil
+    uint32_t          period_count;    // số chu kỳ đã qua
+    uint32_t          period_missed;   // số chu kỳ bị lỡ deadline
+    uint32_t          period_worst_us; // overrun lớn nhất (us)
+    // Thống kê runtime (phần còn lại đọc lười từ kernel khi gọi OSAL_TaskGetStats)
+    uint32_t          delay_count;
+    TaskStatsBase     stats_base;      // mốc bộ đếm kernel của thread lúc gắn task
+    _Atomic uint64_t  susp_ns;         // tổng thời gian đã đỗ (ns)
+    _Atomic uint64_t  susp_since_ns;   // thời điểm bắt đầu đỗ hiện tại (0 = không đỗ)
+    // Task notification
+    _Atomic uint32_t  notify_val;
+    _Atomic int       notify_state;    // futex: NOTIFY_*
+    // Task-local storage (chủ task đọc/ghi không khoá, task khác ghi dưới t->mtx)
+    void* _Atomic     local[OSAL_TASK_LOCAL_SLOTS];
 } LinuxTask;
 
-static LinuxTask g_tasks[OSAL_MAX_TASKS];
+#define TASK_STATE_OFFSET offsetof(LinuxTask, deleting)
+
+// Thread OS thực sự chạy task; sau khi entry trả về được giữ trong cache để gắn task khác
+typedef struct LinuxThread {
+    pthread_t           tid;
+    pid_t               ktid;
+    OsalStack           stack;        // stack từ provider (map == NULL → pthread tự cấp)
+    size_t              stack_req;    // kích thước pthread tự cấp (0 = mặc định)
+    _Atomic int         wake;         // futex: 1 = đã được gắn task mới
+    LinuxTask*          task;         // task đang gắn
+    uint8_t             sched_dirty;  // đã đổi policy/prio → phải reset trước khi về cache
+    uint32_t            ntasks;       // số task đã chạy trên thread (> 0 → cần mốc thống kê)
+    struct LinuxThread* next;         // liên kết trong cache
+} LinuxThread;
+
+enum { TASK_BLK_NONE = 0, TASK_BLK_DELAY, TASK_BLK_SUSPEND, TASK_BLK_NOTIFY };
+
+// notify_state: không có notify / có notify chưa nhận / task đang ngủ chờ notify / Delete đã yêu cầu dừng
+enum { NOTIFY_NONE = 0, NOTIFY_PENDING, NOTIFY_WAITING, NOTIFY_STOP };
+#define NOTIFY_REF_DRAIN (1 << 30)
+
+// Registry: mảng con trỏ chunk (chunk không bao giờ giải phóng → tra cứu handle không cần khoá)
+static LinuxTask* _Atomic g_chunks[OSAL_TASK_NCHUNKS];
+static _Atomic uint32_t   g_nchunks    = 0;
+static _Atomic uint64_t   g_free_top   = 0;  // (ABA tag << 32) | (index + 1)
+static _Atomic uint32_t   g_task_count = 0;
+static pthread_mutex_t    g_grow_mtx   = PTHREAD_MUTEX_INITIALIZER;
+
+// Cache thread rảnh (LIFO: thread vừa chạy xong còn nóng cache)
+static pthread_mutex_t    g_thr_mtx    = PTHREAD_MUTEX_INITIALIZER;
+static LinuxThread*       g_thr_cache  = NULL;
+static uint32_t           g_thr_cached = 0;     // kể cả chỗ đã giữ trước nhưng chưa vào list
+static LinuxThread*       g_thr_zombie = NULL;  // thread của task detached đã thoát, chờ join
+static _Atomic int        g_thr_reset_warned = 0;   // đã log lần đầu thread không về cache vì không reset được
+
+// Sự kiện kết thúc task (OSAL_TaskWaitAny): tăng mỗi lần một task nhả thread
+static _Atomic int        g_exit_seq     = 0;   // futex
+static _Atomic uint32_t   g_exit_waiters = 0;
+
+// CPU isolated (isolcpus ∪ nohz_full), đọc một lần từ sysfs
+#define OSAL_CPU_MAX 32
+static pthread_once_t     g_iso_once = PTHREAD_ONCE_INIT;
+static uint32_t           g_iso_mask = 0;
+static _Atomic uint32_t   g_iso_load[OSAL_CPU_MAX];  // số task đã tự đặt trên mỗi CPU
 
 // TLS: trỏ về task hiện tại (để Delay/Yield xử lý suspend/stop)
 static __thread LinuxTask* tls_task = NULL;
 
-static inline int map_prio_ucos_to_linux(uint8_t p_uc)
+// Số khoá task thread này đang giữ (t->mtx nội bộ + OSAL_Mutex); > 0 thì signal suspend phải hoãn
+// (tránh đỗ khi đang giữ khoá)
+static __thread volatile sig_atomic_t tls_lock_depth = 0;
+static __thread volatile sig_atomic_t tls_park_deferred = 0;
+
+static pthread_once_t g_suspend_sig_once = PTHREAD_ONCE_INIT;
+
+// Ghi nhận thời gian đỗ (clock_gettime an toàn trong signal handler)
+static inline void park_begin(LinuxTask* t)
 {
-    // Linux SCHED_FIFO priority range: 1..99 (1 lowest, 99 highest)
-    // Map tuyến tính 0..255 -> 1..99 (0->1, 255->99)
-    int p = 1 + (int)((p_uc * 98u) / 255u);
-    if (p < 1)  p = 1;
-    if (p > 99) p = 99;
-    return p;
+    atomic_store(&t->susp_since_ns, mono_ns());
+    atomic_store(&t->park_state, 1);
+    futex_wake(&t->park_state, INT_MAX);
 }
 
-static int set_thread_rt_priority(pthread_t tid, uint8_t prio_uc)
+static inline void park_end(LinuxTask* t)
 {
-    int policy = SCHED_FIFO;
-    struct sched_param sp;
-    memset(&sp, 0, sizeof(sp));
-    sp.sched_priority = map_prio_ucos_to_linux(prio_uc);
-
-    int rc = pthread_setschedparam(tid, policy, &sp);
-    if (rc != 0) {
-        // Thường EPERM nếu không có CAP_SYS_NICE → fallback SCHED_OTHER
-        struct sched_param sp2; memset(&sp2, 0, sizeof(sp2));
-        policy = SCHED_OTHER;
-        rc = pthread_setschedparam(tid, policy, &sp2);
-        if (rc != 0) {
-            OSAL_LOG("[OSAL][Task] set prio failed (rc=%d, errno=%d)\r\n", rc, errno);
-            return -1;
-        }
-        OSAL_LOG("[OSAL][Task] fallback SCHED_OTHER (no CAP_SYS_NICE?)\r\n");
-        return 1; // fallback
-    }
-    OSAL_LOG("[OSAL][Task] SCHED_FIFO prio=%d ok\r\n", sp.sched_priority);
-    return 0;
+    atomic_store(&t->park_state, 0);
+    uint64_t since = atomic_exchange(&t->susp_since_ns, 0);
+    if (since) atomic_fetch_add(&t->susp_ns, mono_ns() - since);
 }
 
-static void* task_trampoline(void* arg)
+// Đỗ thread hiện tại cho đến khi park_req về 0 (chỉ dùng syscall futex → an toàn trong signal handler)
+static void task_park_async(LinuxTask* t)
 {
-    LinuxTask* t = (LinuxTask*)arg;
-    tls_task = t;
-
-    // Đặt tên thread (best-effort, giới hạn 16 bytes)
-#if defined(__linux__)
-    if (t->name[0]) {
-        pthread_setname_np(pthread_self(), t->name);
+    park_begin(t);
+    while (atomic_load(&t->park_req)) {
+        futex_wait(&t->park_req, 1, NULL);
     }
-#endif
+    park_end(t);
+}
 
-    // Thiết lập ưu tiên (sau khi thread đã start)
-    if (t->prio_req) {
-        set_thread_rt_priority(pthread_self(), t->prio_req);
+static void suspend_signal_handler(int sig)
+{
+    (void)sig;
+    LinuxTask* t = tls_task;
+    if (!t || !atomic_load(&t->park_req)) return;
+    if (tls_lock_depth > 0) {
+        // Đang trong vùng khoá của OSAL → đỗ khi nhả khoá cuối cùng
+        tls_park_deferred = 1;
+        return;
     }
+    int saved_errno = errno;
+    task_park_async(t);
+    errno = saved_errno;
+}
 
-    // Gọi entry người dùng – cooperative suspend/stop được “bắt” trong OSAL_TaskDelayMs / Yield
-    t->entry(t->arg);
+static void suspend_signal_install(void)
+{
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = suspend_signal_handler;
+    sa.sa_flags   = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(OSAL_SUSPEND_SIGNAL, &sa, NULL);
+}
+
+void osal_task_nopark_enter(void)
+{
+    tls_lock_depth++;
+}
+
+void osal_task_nopark_exit(void)
+{
+    if (--tls_lock_depth == 0 && tls_park_deferred) {
+        tls_park_deferred = 0;
+        if (tls_task && atomic_load(&tls_task->park_req)) task_park_async(tls_task);
+    }
+}
 
-    // Khi entry trả về: đánh dấu kết thúc
+static inline void task_mtx_lock(LinuxTask* t)
+{
+    osal_task_nopark_enter();
     pthread_mutex_lock(&t->mtx);
-    t->running = 0;
+}
+
+static inline void task_mtx_unlock(LinuxTask* t)
+{
     pthread_mutex_unlock(&t->mtx);
+    osal_task_nopark_exit();
+}
+
+// Task OSAL đang chạy trên thread/fiber hiện tại (NULL nếu không phải task OSAL)
+static inline LinuxTask* task_self(void)
+{
+    OsalFiber* f = osal_fiber_self();
+    return f ? (LinuxTask*)osal_fiber_owner(f) : tls_task;
+}
+
+// Gọi khi đang giữ t->mtx: đánh thức task đang chờ trong Delay / suspend
+static inline void task_wake_locked(LinuxTask* t)
+{
+    if (t->fib) osal_fiber_wake(t->fib);
+    else        pthread_cond_broadcast(&t->cv);
+}
+
+// Gọi khi đang giữ t->mtx: fiber không được đỗ carrier trên t->cv → nhả khoá rồi park
+static inline void task_fiber_park_locked(LinuxTask* t)
+{
+    task_mtx_unlock(t);
+    osal_fiber_park();
+    task_mtx_lock(t);
+}
+
+// Gọi khi đang giữ t->mtx, người gọi là fiber: chờ task khác kết thúc mà không đỗ carrier trên cv
+// (task đích có thể là fiber cùng carrier) → nhả khoá, nhường carrier một bước. Trả về 1 nếu qua deadline
+static inline int task_fiber_backoff_locked(LinuxTask* t, uint32_t* spin, uint64_t deadline_ns)
+{
+    task_mtx_unlock(t);
+    int expired = osal_fiber_backoff(spin, deadline_ns);
+    task_mtx_lock(t);
+    return expired;
+}
+
+// Gọi khi đang giữ t->mtx: chờ Resume/Delete (cooperative suspend)
+static void task_wait_resumed_locked(LinuxTask* t)
+{
+    uint8_t prev = t->blocked;
+    t->blocked = TASK_BLK_SUSPEND;
+    park_begin(t);
+    while (t->running && t->suspended) {
+        if (t->fib) task_fiber_park_locked(t);
+        else        pthread_cond_wait(&t->cv, &t->mtx);
+    }
+    park_end(t);
+    t->blocked = prev;
+}
+
+static int set_thread_rt_priority(LinuxTask* t, uint8_t prio)
+{
+    // Mapping prio → policy/giá trị Linux do priority domain quyết định (bảng band theo backend)
+    return osal_prio_apply(t->tid, t->ktid, prio, NULL);
+}
+
+// Layout struct sched_attr của kernel (glibc cũ không có wrapper sched_setattr)
+typedef struct {
+    uint32_t size;
+    uint32_t sched_policy;
+    uint64_t sched_flags;
+    int32_t  sched_nice;
+    uint32_t sched_priority;
+    uint64_t sched_runtime;    // ns
+    uint64_t sched_deadline;   // ns
+    uint64_t sched_period;     // ns
+} OsalSchedAttr;
+
+// Áp dụng SCHED_DEADLINE cho thread gọi; trả về 0 hoặc errno (EBUSY = admission control từ chối)
+static int set_thread_deadline(uint32_t runtime_us, uint32_t deadline_us, uint32_t period_us)
+{
+#ifdef SYS_sched_setattr
+    OsalSchedAttr sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.size           = sizeof(sa);
+    sa.sched_policy   = SCHED_DEADLINE;
+    sa.sched_runtime  = (uint64_t)runtime_us  * 1000u;
+    sa.sched_deadline = (uint64_t)deadline_us * 1000u;
+    sa.sched_period   = (uint64_t)period_us   * 1000u;
+    if (syscall(SYS_sched_setattr, 0, &sa, 0) != 0) {
+        int err = errno;
+        OSAL_LOG("[OSAL][Task] SCHED_DEADLINE %u/%u/%u us failed (errno=%d)\r\n",
+                 (unsigned)runtime_us, (unsigned)deadline_us, (unsigned)period_us, err);
+        return err;
+    }
+    OSAL_LOG("[OSAL][Task] SCHED_DEADLINE %u/%u/%u us ok\r\n",
+             (unsigned)runtime_us, (unsigned)deadline_us, (unsigned)period_us);
+    return 0;
+#else
+    (void)runtime_us; (void)deadline_us; (void)period_us;
+    return ENOSYS;
+#endif
+}
+
+// ===== Thread layer =====
+
+static inline size_t thread_stack_size(const LinuxThread* thr)
+{
+    return thr->stack.map ? thr->stack.size : thr->stack_req;
+}
+
+static void task_reap(LinuxTask* t);
+static void thread_zombie_push(LinuxThread* thr);
+static void task_gate_wait(LinuxTask* t);
+static void task_checkpoint(LinuxTask* t);
+static void task_sleep_until(const struct timespec* deadline);
+
+// Thread nhả task: sau khi báo thr_done, thread không được chạm vào t nữa (trừ khi t đã detach)
+static void task_release(LinuxTask* t, int cached)
+{
+    task_mtx_lock(t);
+    t->running  = 0;
+    t->thr_exit = cached ? 0 : 1;
+    t->thr_done = 1;
+    int detached = t->detached;
+    task_mtx_unlock(t);
     pthread_cond_broadcast(&t->cv);
 
-    return NULL;
+    atomic_fetch_add(&g_exit_seq, 1);
+    if (atomic_load(&g_exit_waiters)) futex_wake(&g_exit_seq, INT_MAX);
+
+    if (detached) {
+        // Không ai Join: tự dọn. Thread đang thoát không tự join được → để Create/Detach sau join hộ
+        if (!cached) thread_zombie_push(t->thr);
+        t->thr_exit = 0;
+        task_reap(t);
+    }
 }
 
-// ===== Helper quản lý slot =====
-static LinuxTask* alloc_task_slot(void)
+// Cleanup khi task bị stop (pthread_exit trong Delay/Yield) → thread thoát, không về cache
+static void task_stop_cleanup(void* arg)
 {
-    for (int i = 0; i < OSAL_MAX_TASKS; ++i) {
-        if (!g_tasks[i].used) {
-            LinuxTask* t = &g_tasks[i];
-            memset(t, 0, sizeof(*t));
-            t->used = 1;
-            pthread_mutex_init(&t->mtx, NULL);
-            pthread_cond_init(&t->cv, NULL);
-            t->running = 1;
-            return t;
+    LinuxThread* thr = (LinuxThread*)arg;
+    tls_task = NULL;
+    task_release(thr->task, 0);
+}
+
+// Giữ trước một chỗ trong cache (trước khi báo thr_done để người dọn biết có cần join không)
+static int thread_cache_reserve(const LinuxTask* t)
+{
+    if (t->dl_runtime_us) return 0;     // không tái sử dụng thread đã chạy SCHED_DEADLINE
+    pthread_mutex_lock(&g_thr_mtx);
+    int ok = g_thr_cached < OSAL_THREAD_CACHE_MAX;
+    if (ok) g_thr_cached++;
+    pthread_mutex_unlock(&g_thr_mtx);
+    return ok;
+}
+
+static void thread_cache_push(LinuxThread* thr)
+{
+    atomic_store(&thr->wake, 0);
+    thr->task = NULL;
+    pthread_mutex_lock(&g_thr_mtx);
+    thr->next   = g_thr_cache;
+    g_thr_cache = thr;
+    pthread_mutex_unlock(&g_thr_mtx);
+}
+
+// Lấy thread rảnh có stack phù hợp (req = 0: stack mặc định; > 0: không nhỏ hơn, không quá 2 lần)
+static LinuxThread* thread_cache_pop(size_t req)
+{
+    size_t want = req ? osal_stack_round(req) : 0;
+    pthread_mutex_lock(&g_thr_mtx);
+    for (LinuxThread** pp = &g_thr_cache; *pp; pp = &(*pp)->next) {
+        size_t have = thread_stack_size(*pp);
+        if ((want == 0 && have == 0) || (want && have >= want && have <= 2 * want)) {
+            LinuxThread* thr = *pp;
+            *pp = thr->next;
+            g_thr_cached--;
+            pthread_mutex_unlock(&g_thr_mtx);
+            return thr;
         }
     }
+    pthread_mutex_unlock(&g_thr_mtx);
     return NULL;
 }
 
-static void free_task_slot(LinuxTask* t)
+// Trả lại thread vừa thread_cache_pop mà không dùng được (chỗ của nó vừa được nhả)
+static void thread_cache_return(LinuxThread* thr)
 {
-    if (!t) return;
-    pthread_mutex_destroy(&t->mtx);
-    pthread_cond_destroy(&t->cv);
-    memset(t, 0, sizeof(*t));
+    pthread_mutex_lock(&g_thr_mtx);
+    g_thr_cached++;
+    pthread_mutex_unlock(&g_thr_mtx);
+    thread_cache_push(thr);
 }
 
-// ===== API =====
+// Join + dọn thread đã thoát
+static void thread_reap(LinuxThread* thr)
+{
+    (void)pthread_join(thr->tid, NULL);
+    osal_stack_free(&thr->stack);
+    free(thr);
+}
 
-OSAL_Status OSAL_TaskCreate(OSAL_TaskHandle* out, OSAL_TaskEntry entry, void* arg, const OSAL_TaskAttr* attr)
+static void thread_zombie_push(LinuxThread* thr)
 {
-    if (!out || !entry) return OSAL_EINVAL;
+    pthread_mutex_lock(&g_thr_mtx);
+    thr->next    = g_thr_zombie;
+    g_thr_zombie = thr;
+    pthread_mutex_unlock(&g_thr_mtx);
+}
 
-    LinuxTask* t = alloc_task_slot();
-    if (!t) return OSAL_EINIT;
+static void thread_zombie_reap(void)
+{
+    pthread_mutex_lock(&g_thr_mtx);
+    LinuxThread* thr = g_thr_zombie;
+    g_thr_zombie = NULL;
+    pthread_mutex_unlock(&g_thr_mtx);
+    while (thr) {
+        LinuxThread* next = thr->next;
+        thread_reap(thr);
+        thr = next;
+    }
+}
 
-    t->entry = entry;
-    t->arg   = arg;
-    t->suspended = 0;
+// Trả thread về lập lịch mặc định trước khi vào cache. Thất bại (vd. nice đã bị nâng, không có
+// CAP_SYS_NICE / RLIMIT_NICE để hạ lại) → 0: thread không được tái sử dụng
+static int thread_sched_reset(LinuxThread* thr)
+{
+    if (!thr->sched_dirty) return 1;
+    struct sched_param sp;
+    memset(&sp, 0, sizeof(sp));
+    if (pthread_setschedparam(thr->tid, SCHED_OTHER, &sp) != 0) return 0;
+    if (setpriority(PRIO_PROCESS, (id_t)thr->ktid, 0) != 0) return 0;
+    thr->sched_dirty = 0;
+    return 1;
+}
 
-    if (attr && attr->name) {
-        strncpy(t->name, attr->name, sizeof(t->name)-1);
-        t->name[sizeof(t->name)-1] = 0;
+// Mốc CPU time / runqueue / context switch của thread hiện tại khi gắn task (chỉ thread tái sử dụng)
+static void thread_stats_base(LinuxThread* thr, TaskStatsBase* b)
+{
+    if (thr->ntasks++ == 0) return;     // thread mới: bộ đếm chỉ có phần khởi động, bỏ qua
+
+    struct rusage ru;
+    if (getrusage(RUSAGE_THREAD, &ru) == 0) {
+        b->vcsw  = (uint32_t)ru.ru_nvcsw;
+        b->ivcsw = (uint32_t)ru.ru_nivcsw;
     }
-    if (attr) {
-        t->prio_req = attr->prio; // map khi set schedparam
+    // schedstat: cùng nguồn với CPU clock của thread (sum_exec_runtime) và runq_wait_us
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/self/task/%d/schedstat", (int)thr->ktid);
+    FILE* f = fopen(path, "r");
+    unsigned long long run_ns = 0, wait_ns = 0;
+    if (f && fscanf(f, "%llu %llu", &run_ns, &wait_ns) == 2) {
+        b->cpu_ns  = run_ns;
+        b->runq_ns = wait_ns;
+    } else {
+        struct timespec ts;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+            b->cpu_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+        }
     }
+    if (f) fclose(f);
+}
 
-    pthread_attr_t a;
-    pthread_attr_init(&a);
+// Chạy một task trên thread hiện tại; trả về 1 nếu thread về cache, 0 nếu phải thoát
+static int thread_run_task(LinuxThread* thr, LinuxTask* t)
+{
+    TaskStatsBase base;
+    memset(&base, 0, sizeof(base));
+    thread_stats_base(thr, &base);
 
-    // Stack size nếu có
-    if (attr && attr->stack_size) {
-        size_t ss = attr->stack_size;
-        // Linux thường cần tối thiểu ~PTHREAD_STACK_MIN, nhưng attr->stack_size từ RTOS là bytes, OK.
-        if (ss < 16384) ss = 16384; // guard tối thiểu
-        pthread_attr_setstacksize(&a, ss);
-    }
+    tls_task = t;
+    task_mtx_lock(t);
+    t->tid        = thr->tid;
+    t->ktid       = thr->ktid;
+    t->stats_base = base;
+    task_mtx_unlock(t);
 
-    // Detached? => Không. Ta join khi delete/stop để đồng bộ dọn tài nguyên.
-    pthread_attr_setdetachstate(&a, PTHREAD_CREATE_JOINABLE);
+    // Đặt tên thread (best-effort, giới hạn 16 bytes)
+#if defined(__linux__)
+    pthread_setname_np(thr->tid, t->name[0] ? t->name : "osal");
+#endif
 
-    int rc = pthread_create(&t->tid, &a, task_trampoline, t);
-    pthread_attr_destroy(&a);
-    if (rc != 0) {
-        OSAL_LOG("[OSAL][Task] pthread_create failed rc=%d errno=%d\r\n", rc, errno);
-        free_task_slot(t);
-        return OSAL_EINIT;
+    // Thiết lập ưu tiên (sau khi thread đã start)
+    if (t->dl_runtime_us) {
+        // Deadline class: báo kết quả admission về OSAL_TaskCreate trước khi chạy entry
+        int err = set_thread_deadline(t->dl_runtime_us, t->dl_deadline_us, t->dl_period_us);
+        task_mtx_lock(t);
+        t->start_err  = err;
+        t->start_done = 1;
+        task_mtx_unlock(t);
+        pthread_cond_broadcast(&t->cv);
+        if (err) {
+            tls_task = NULL;
+            task_release(t, 0);
+            return 0;
+        }
+        thr->sched_dirty = 1;
+    } else if (t->prio_set) {
+        // Giữ khoá: ChangePrio song song không bị prio ban đầu ghi đè
+        task_mtx_lock(t);
+        set_thread_rt_priority(t, t->prio_req);
+        thr->sched_dirty = 1;
+        task_mtx_unlock(t);
     }
+    // Thread từ cache luôn ở lập lịch mặc định (thread_sched_reset trước khi vào cache)
 
-    *out = (OSAL_TaskHandle)t;
-    return OSAL_OK;
+    // Gọi entry người dùng – cooperative suspend/stop được “bắt” trong OSAL_TaskDelayMs / Yield
+    pthread_cleanup_push(task_stop_cleanup, thr);
+    task_gate_wait(t);
+    t->entry(t->arg);
+    pthread_cleanup_pop(0);
+
+    // Khi entry trả về: reset lập lịch trước, chỉ thread reset được mới giữ chỗ cache (còn chỗ thì về cache)
+    tls_task = NULL;
+    task_mtx_lock(t);
+    t->thr_leaving = 1;         // ChangePrio từ đây không đổi prio thread nữa → reset không bị ghi đè
+    task_mtx_unlock(t);
+    int reset = thread_sched_reset(thr);
+    if (!reset && !atomic_exchange(&g_thr_reset_warned, 1)) {
+        OSAL_LOG("[OSAL][Task] cannot reset sched params of finished threads (no CAP_SYS_NICE?): "
+                 "threads whose prio changed exit instead of being cached\r\n");
+    }
+    int cached = reset && thread_cache_reserve(t);
+    task_release(t, cached);    // thr_done: người dọn join thread nếu nó không về cache
+    if (!cached) return 0;
+    thread_cache_push(thr);
+    return 1;
 }
 
-// Cooperative suspend: đặt cờ và để task “đỗ” trong OSAL_TaskDelayMs / Yield
-OSAL_Status OSAL_TaskSuspend(OSAL_TaskHandle h)
+static void* thread_main(void* arg)
 {
-    LinuxTask* t = (LinuxTask*)h;
-    if (!t || !t->used) return OSAL_EINVAL;
+    LinuxThread* thr = (LinuxThread*)arg;
+    thr->tid  = pthread_self();   // không phụ thuộc thời điểm pthread_create ghi tid ở thread cha
+    thr->ktid = (pid_t)syscall(SYS_gettid);
 
-    pthread_mutex_lock(&t->mtx);
-    t->suspended = 1;
-    pthread_mutex_unlock(&t->mtx);
-    return OSAL_OK;
+    while (thread_run_task(thr, thr->task)) {
+        // Đỗ trong cache đến khi OSAL_TaskCreate gắn task mới
+        while (!atomic_load(&thr->wake)) {
+            futex_wait(&thr->wake, 0, NULL);
+        }
+    }
+    return NULL;
 }
 
-OSAL_Status OSAL_TaskResume(OSAL_TaskHandle h)
+// ===== Task fiber =====
+
+static void fiber_task_main(void* arg)
 {
-    LinuxTask* t = (LinuxTask*)h;
-    if (!t || !t->used) return OSAL_EINVAL;
+    LinuxTask* t = (LinuxTask*)arg;
+    task_gate_wait(t);
+    t->entry(t->arg);
+}
 
-    pthread_mutex_lock(&t->mtx);
-    t->suspended = 0;
-    pthread_mutex_unlock(&t->mtx);
-    pthread_cond_broadcast(&t->cv);
-    return OSAL_OK;
+// Carrier gọi sau khi fiber đã rời stack của nó (entry trả về hoặc bị stop)
+static void fiber_task_done(void* arg)
+{
+    task_release((LinuxTask*)arg, 1);
 }
 
-// Cooperative delete/stop: yêu cầu dừng + join
-OSAL_Status OSAL_TaskDelete(OSAL_TaskHandle h)
+static OSAL_Status fiber_task_create(LinuxTask* t, const OSAL_TaskAttr* attr)
 {
-    LinuxTask* t = (LinuxTask*)h;
-    if (!t || !t->used) return OSAL_EINVAL;
+    // Fiber không có thread riêng: không signal, không SCHED_DEADLINE, không affinity riêng
+    if (attr->dl_runtime_us || attr->cpu_mask ||
+        (attr->flags & (OSAL_TASK_F_PREEMPT_SUSPEND | OSAL_TASK_F_ISOLATED_CPU))) {
+        return OSAL_EINVAL;
+    }
+    size_t stack = attr->stack_size ? attr->stack_size : OSAL_FIBER_STACK_DEFAULT;
+    int err = osal_fiber_create(&t->fib, stack, osal_prio_rank(attr->prio),
+                                fiber_task_main, t, fiber_task_done, t);
+    if (err) {
+        OSAL_LOG("[OSAL][Task] %s: fiber create failed (errno=%d)\r\n", t->name, err);
+        return (err == EINVAL) ? OSAL_EINVAL : OSAL_EINIT;
+    }
+    t->tid = osal_fiber_carrier(t->fib);
+    osal_fiber_start(t->fib);
+    return OSAL_OK;
+}
 
-    // Báo dừng
-    pthread_mutex_lock(&t->mtx);
-    t->running = 0;
-    t->suspended = 0;
-    pthread_mutex_unlock(&t->mtx);
-    pthread_cond_broadcast(&t->cv);
+// ===== Affinity helpers =====
 
-    // Chờ thread kết thúc
-    (void)pthread_join(t->tid, NULL);
-    free_task_slot(t);
-    return OSAL_OK;
+// Parse cpulist dạng "1,3-5" (format của sysfs) thành bitmask
+static uint32_t parse_cpulist(const char* s)
+{
+    uint32_t mask = 0;
+    while (*s) {
+        char* end;
+        long a = strtol(s, &end, 10);
+        if (end == s) break;
+        long b = a;
+        if (*end == '-') {
+            s = end + 1;
+            b = strtol(s, &end, 10);
+            if (end == s) break;
+        }
+        for (long c = a; c <= b && c < OSAL_CPU_MAX; ++c) {
+            if (c >= 0) mask |= 1u << c;
+        }
+        s = end;
+        if (*s == ',') ++s;
+        else break;
+    }
+    return mask;
 }
 
-// Đổi priority runtime
-OSAL_Status OSAL_TaskChangePrio(OSAL_TaskHandle h, uint8_t new_prio)
+static uint32_t read_cpulist_file(const char* path)
 {
-    LinuxTask* t = (LinuxTask*)h;
-    if (!t || !t->used) return OSAL_EINVAL;
+    char buf[128];
+    FILE* f = fopen(path, "r");
+    if (!f) return 0;
+    uint32_t mask = 0;
+    if (fgets(buf, sizeof(buf), f)) mask = parse_cpulist(buf);
+    fclose(f);
+    return mask;
+}
 
-    int rc = set_thread_rt_priority(t->tid, new_prio);
-    if (rc >= 0) {
-        t->prio_req = new_prio;
-        return OSAL_OK;
+static void iso_cpus_init(void)
+{
+    g_iso_mask = read_cpulist_file("/sys/devices/system/cpu/isolated") |
+                 read_cpulist_file("/sys/devices/system/cpu/nohz_full");
+    if (g_iso_mask) {
+        OSAL_LOG("[OSAL][Task] isolated CPUs mask=0x%x\r\n", (unsigned)g_iso_mask);
     }
-    return OSAL_EINIT;
 }
 
-OSAL_Status OSAL_TaskGetState(OSAL_TaskHandle h, OSAL_TaskState* state)
+// Chọn CPU isolated ít task nhất (trong allowed nếu != 0); -1 nếu không có
+static int pick_isolated_cpu(uint32_t allowed)
 {
-    LinuxTask* t = (LinuxTask*)h;
-    if (!t || !state) return OSAL_EINVAL;
+    pthread_once(&g_iso_once, iso_cpus_init);
+    uint32_t cand = g_iso_mask & (allowed ? allowed : UINT32_MAX);
+    int best = -1;
+    uint32_t best_load = UINT32_MAX;
+    for (int c = 0; c < OSAL_CPU_MAX; ++c) {
+        if (!(cand & (1u << c))) continue;
+        uint32_t l = atomic_load(&g_iso_load[c]);
+        if (l < best_load) { best = c; best_load = l; }
+    }
+    if (best >= 0) atomic_fetch_add(&g_iso_load[best], 1u);
+    return best;
+}
 
-    pthread_mutex_lock(&t->mtx);
-    if (!t->running) {
-        *state = OSAL_TASK_STATE_INVALID;  // hoặc TERMINATED nếu bạn có enum đó
-    } else if (t->suspended) {
-        *state = OSAL_TASK_STATE_WAITING;
-    } else {
-        *state = OSAL_TASK_STATE_RUNNING;
+static void release_isolated_cpu(LinuxTask* t)
+{
+    if (t->iso_cpu) {
+        atomic_fetch_sub(&g_iso_load[t->iso_cpu - 1], 1u);
+        t->iso_cpu = 0;
     }
-    pthread_mutex_unlock(&t->mtx);
-    return OSAL_OK;
 }
 
-OSAL_Status OSAL_TaskGetName(OSAL_TaskHandle h, const char** name)
+// mask → cpu_set_t; 0 nếu mask không chứa CPU nào đang có trong hệ thống
+static int mask_to_cpuset(uint32_t mask, cpu_set_t* set)
 {
-    LinuxTask* t = (LinuxTask*)h;
-    if (!t || !name) return OSAL_EINVAL;
-    *name = t->name[0] ? t->name : NULL;
-    return OSAL_OK;
+    long ncpu = sysconf(_SC_NPROCESSORS_CONF);
+    if (ncpu <= 0 || ncpu > OSAL_CPU_MAX) ncpu = OSAL_CPU_MAX;
+    CPU_ZERO(set);
+    for (long c = 0; c < ncpu; ++c) {
+        if (mask & (1u << c)) CPU_SET(c, set);
+    }
+    return CPU_COUNT(set) > 0;
 }
 
-// ===== Scheduling helpers (cooperative suspend/stop hook) =====
+// ===== Bản công bố (seqlock) =====
 
-void OSAL_TaskYield(void)
+// Gọi khi đang giữ t->mtx (người ghi duy nhất của slot). Dữ liệu ghi release sau seq lẻ → không
+// bị kéo lên trước; người đọc load acquire rồi so lại seq.
+static inline void pub_begin(LinuxTask* t)
 {
-    // Nếu task đang bị suspend → chờ đến khi resume
-    if (tls_task) {
-        LinuxTask* t = tls_task;
-        pthread_mutex_lock(&t->mtx);
-        while (t->running && t->suspended) {
-            pthread_cond_wait(&t->cv, &t->mtx);
-        }
-        int still_running = t->running;
-        pthread_mutex_unlock(&t->mtx);
+    uint32_t s = atomic_load_explicit(&t->pub.seq, memory_order_relaxed);
+    atomic_store_explicit(&t->pub.seq, s + 1u, memory_order_relaxed);
+}
 
-        if (!still_running) {
-            // Thoát trơn tru: return về entry → trampoline set running=0
-            pthread_exit(NULL);
-        }
+static inline void pub_end(LinuxTask* t)
+{
+    uint32_t s = atomic_load_explicit(&t->pub.seq, memory_order_relaxed);
+    atomic_store_explicit(&t->pub.seq, s + 1u, memory_order_release);
+}
+
+// Công bố task vừa Create xong (gọi khi đang giữ t->mtx)
+static void pub_publish_locked(LinuxTask* t, uint64_t h, uint32_t flags)
+{
+    uint64_t w[OSAL_TASK_PUB_WORDS] = { 0 };
+    memcpy(w, t->name, sizeof(t->name));
+    pub_begin(t);
+    for (uint32_t i = 0; i < OSAL_TASK_PUB_WORDS; ++i) {
+        atomic_store_explicit(&t->pub.name[i], w[i], memory_order_release);
     }
-    sched_yield();
+    atomic_store_explicit(&t->pub.cpu_mask, t->cpu_mask, memory_order_release);
+    atomic_store_explicit(&t->pub.flags, flags, memory_order_release);
+    atomic_store_explicit(&t->pub.prio, t->prio_req, memory_order_release);
+    atomic_store_explicit(&t->pub.handle, h, memory_order_release);
+    pub_end(t);
 }
 
-void OSAL_TaskDelayMs(uint32_t ms)
+// Cập nhật prio / affinity đã công bố (gọi khi đang giữ t->mtx)
+static void pub_update_locked(LinuxTask* t)
 {
-    // Chia nhỏ delay để kiểm tra suspend/stop mượt mà
-    const uint32_t slice_ms = (ms > 50u) ? 10u : ms; // kiểm tra mỗi 10ms nếu delay dài
-    uint32_t remain = ms;
+    if (!atomic_load_explicit(&t->pub.handle, memory_order_relaxed)) return;
+    pub_begin(t);
+    atomic_store_explicit(&t->pub.cpu_mask, t->cpu_mask, memory_order_release);
+    atomic_store_explicit(&t->pub.prio, t->prio_req, memory_order_release);
+    pub_end(t);
+}
 
-    while (remain > 0) {
-        uint32_t d = (remain > slice_ms) ? slice_ms : remain;
-        struct timespec ts;
-        ts.tv_sec  = d / 1000u;
-        ts.tv_nsec = (long)(d % 1000u) * 1000000L;
-        nanosleep(&ts, NULL);
-        remain -= d;
-
-        if (tls_task) {
-            LinuxTask* t = tls_task;
-            pthread_mutex_lock(&t->mtx);
-            // Nếu suspend → chờ đến khi resume
-            while (t->running && t->suspended) {
-                pthread_cond_wait(&t->cv, &t->mtx);
-            }
-            int still_running = t->running;
-            pthread_mutex_unlock(&t->mtx);
-            if (!still_running) {
-                pthread_exit(NULL);
-            }
+// Chép các trường đã công bố; trả về handle (0 = slot không có task đã công bố)
+static uint64_t pub_load(const LinuxTask* t, uint64_t* w, OSAL_TaskInfo* info)
+{
+    uint64_t h = atomic_load_explicit(&t->pub.handle, memory_order_acquire);
+    if (!h) return 0;
+    for (uint32_t i = 0; i < OSAL_TASK_PUB_WORDS; ++i) {
+        w[i] = atomic_load_explicit(&t->pub.name[i], memory_order_acquire);
+    }
+    info->cpu_mask = atomic_load_explicit(&t->pub.cpu_mask, memory_order_acquire);
+    info->flags    = atomic_load_explicit(&t->pub.flags, memory_order_acquire);
+    info->prio     = atomic_load_explicit(&t->pub.prio, memory_order_acquire);
+    return h;
+}
+
+// Đọc bản công bố nhất quán; 0 nếu slot không có task đã công bố
+static int pub_read(LinuxTask* t, OSAL_TaskInfo* info)
+{
+    uint64_t w[OSAL_TASK_PUB_WORDS];
+    uint64_t h;
+    for (uint32_t tries = 0;; ++tries) {
+        if (tries == OSAL_TASK_PUB_SPIN) {
+            // Người ghi giữ lâu: chờ trên khoá của nó (ngủ trong kernel → người ghi bị preempt được chạy)
+            task_mtx_lock(t);
+            h = pub_load(t, w, info);
+            task_mtx_unlock(t);
+            break;
         }
+        uint32_t s1 = atomic_load_explicit(&t->pub.seq, memory_order_acquire);
+        if (s1 & 1u) {
+            sched_yield();      // người ghi giữ t->mtx, có thể vừa bị preempt
+            continue;
+        }
+        h = pub_load(t, w, info);
+        if (atomic_load_explicit(&t->pub.seq, memory_order_relaxed) == s1) break;
     }
+    if (!h) return 0;
+
+    info->handle = (OSAL_TaskHandle)h;
+    size_t len = (sizeof(w) < sizeof(info->name)) ? sizeof(w) : sizeof(info->name) - 1;
+    memcpy(info->name, w, len);
+    info->name[len] = 0;
+    return 1;
 }
 
-// ===== Optional: thống kê / duyệt =====
+// ===== Helper quản lý slot =====
+static inline LinuxTask* slot_at(uint32_t idx)
+{
+    LinuxTask* chunk = atomic_load_explicit(&g_chunks[idx / OSAL_TASK_CHUNK], memory_order_acquire);
+    return chunk ? &chunk[idx % OSAL_TASK_CHUNK] : NULL;
+}
 
-uint32_t OSAL_TaskCount(void)
+static inline OSAL_TaskHandle handle_of(const LinuxTask* t, uint32_t gen)
 {
-    uint32_t n = 0;
-    for (int i = 0; i < OSAL_MAX_TASKS; ++i)
-        if (g_tasks[i].used) ++n;
-    return n;
+    return ((uint64_t)gen << OSAL_HANDLE_IDX_BITS) | (uint64_t)(t->idx + 1u);
 }
 
-OSAL_Status OSAL_TaskForEach(void (*cb)(OSAL_TaskHandle h, void* arg), void* arg)
+// Tra cứu không khoá: NULL nếu handle sai hoặc đã cũ (slot đã bị free / tái sử dụng)
+static LinuxTask* task_from_handle(OSAL_TaskHandle h)
 {
-    if (!cb) return OSAL_EINVAL;
-    for (int i = 0; i < OSAL_MAX_TASKS; ++i)
-        if (g_tasks[i].used) cb((OSAL_TaskHandle)&g_tasks[i], arg);
+    uint32_t i1 = (uint32_t)(h & OSAL_HANDLE_IDX_MASK);
+    if (i1 == 0 || i1 > OSAL_MAX_TASKS) return NULL;
+
+    LinuxTask* t = slot_at(i1 - 1u);
+    if (!t) return NULL;
+    uint32_t gen = atomic_load_explicit(&t->gen, memory_order_acquire);
+    if (!(gen & 1u) || (uint64_t)gen != (h >> OSAL_HANDLE_IDX_BITS)) return NULL;
+    return t;
+}
+
+// Như task_from_handle nhưng trả về slot đã khoá mtx, generation được kiểm tra lại dưới khoá
+static LinuxTask* task_lock(OSAL_TaskHandle h)
+{
+    LinuxTask* t = task_from_handle(h);
+    if (!t) return NULL;
+    task_mtx_lock(t);
+    if (task_from_handle(h) != t) {
+        task_mtx_unlock(t);
+        return NULL;
+    }
+    return t;
+}
+
+static inline void task_notify_unpin(LinuxTask* t)
+{
+    if (atomic_fetch_sub(&t->notify_refs, 1) == (NOTIFY_REF_DRAIN | 1)) {
+        futex_wake(&t->notify_refs, 1);     // free_task_slot đang chờ Notify cuối rời slot
+    }
+}
+
+// Notify không khoá: giữ slot trước rồi mới kiểm tra generation. Cặp với free_task_slot (đổi generation
+// rồi chờ notify_refs về 0), cả hai seq_cst → hoặc Notify thấy handle đã hết hạn, hoặc bên dọn chờ Notify
+// xong → không ghi nhầm vào task mới cấp lại slot
+static LinuxTask* task_notify_pin(OSAL_TaskHandle h)
+{
+    uint32_t i1 = (uint32_t)(h & OSAL_HANDLE_IDX_MASK);
+    if (i1 == 0 || i1 > OSAL_MAX_TASKS) return NULL;
+
+    LinuxTask* t = slot_at(i1 - 1u);
+    if (!t) return NULL;
+    atomic_fetch_add(&t->notify_refs, 1);
+    uint32_t gen = atomic_load(&t->gen);
+    if (!(gen & 1u) || (uint64_t)gen != (h >> OSAL_HANDLE_IDX_BITS)) {
+        task_notify_unpin(t);
+        return NULL;
+    }
+    return t;
+}
+
+// Gọi sau khi đã đổi generation: chờ các Notify đang giữ slot rời đi (Notify không block → chờ ngắn)
+static void task_notify_drain(LinuxTask* t)
+{
+    int r = atomic_fetch_or(&t->notify_refs, NOTIFY_REF_DRAIN) | NOTIFY_REF_DRAIN;
+    while (r != NOTIFY_REF_DRAIN) {
+        futex_wait(&t->notify_refs, r, NULL);
+        r = atomic_load(&t->notify_refs);
+    }
+    atomic_fetch_and(&t->notify_refs, ~NOTIFY_REF_DRAIN);   // Notify trễ (handle cũ) vẫn có thể đang +1/-1
+}
+
+static void push_free_chain(LinuxTask* first, LinuxTask* last)
+{
+    uint64_t top = atomic_load_explicit(&g_free_top, memory_order_acquire);
+    uint64_t nxt;
+    do {
+        atomic_store_explicit(&last->next_free, (uint32_t)top, memory_order_relaxed);
+        nxt = (((top >> 32) + 1u) << 32) | (uint64_t)(first->idx + 1u);
+    } while (!atomic_compare_exchange_weak_explicit(&g_free_top, &top, nxt,
+                                                    memory_order_release, memory_order_acquire));
+}
+
+// Thêm một chunk mới vào registry (hiếm khi gọi → dùng mutex)
+static int grow_registry(void)
+{
+    pthread_mutex_lock(&g_grow_mtx);
+    if ((uint32_t)atomic_load(&g_free_top) != 0) {
+        // Thread khác vừa grow xong
+        pthread_mutex_unlock(&g_grow_mtx);
+        return 1;
+    }
+    uint32_t n = atomic_load(&g_nchunks);
+    if (n >= OSAL_TASK_NCHUNKS) {
+        pthread_mutex_unlock(&g_grow_mtx);
+        return 0;
+    }
+    LinuxTask* chunk = (LinuxTask*)calloc(OSAL_TASK_CHUNK, sizeof(LinuxTask));
+    if (!chunk) {
+        pthread_mutex_unlock(&g_grow_mtx);
+        return 0;
+    }
+
+    // cv dùng CLOCK_MONOTONIC để deadline của Delay không bị ảnh hưởng khi chỉnh giờ hệ thống
+    pthread_condattr_t ca;
+    pthread_condattr_init(&ca);
+    pthread_condattr_setclock(&ca, CLOCK_MONOTONIC);
+    for (uint32_t i = 0; i < OSAL_TASK_CHUNK; ++i) {
+        LinuxTask* t = &chunk[i];
+        pthread_mutex_init(&t->mtx, NULL);
+        pthread_cond_init(&t->cv, &ca);
+        t->idx = n * OSAL_TASK_CHUNK + i;
+        atomic_init(&t->gen, 0);
+        atomic_init(&t->next_free, (i + 1 < OSAL_TASK_CHUNK) ? t->idx + 2u : 0u);
+        atomic_init(&t->notify_refs, 0);
+    }
+    pthread_condattr_destroy(&ca);
+
+    atomic_store_explicit(&g_chunks[n], chunk, memory_order_release);
+    atomic_store(&g_nchunks, n + 1u);
+    push_free_chain(&chunk[0], &chunk[OSAL_TASK_CHUNK - 1]);
+    pthread_mutex_unlock(&g_grow_mtx);
+    return 1;
+}
+
+// O(1), lock-free (Treiber stack có ABA tag); chỉ khoá khi cần grow
+static LinuxTask* alloc_task_slot(void)
+{
+    for (;;) {
+        uint64_t top = atomic_load_explicit(&g_free_top, memory_order_acquire);
+        uint32_t i1  = (uint32_t)top;
+        if (i1 == 0) {
+            if (!grow_registry()) return NULL;
+            continue;
+        }
+        LinuxTask* t = slot_at(i1 - 1u);
+        uint64_t nxt = (((top >> 32) + 1u) << 32) |
+                       atomic_load_explicit(&t->next_free, memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(&g_free_top, &top, nxt,
+                                                  memory_order_acquire, memory_order_acquire)) {
+            task_mtx_lock(t);
+            memset((char*)t + TASK_STATE_OFFSET, 0, sizeof(*t) - TASK_STATE_OFFSET);
+            t->running = 1;
+            atomic_fetch_add_explicit(&t->gen, 1u, memory_order_release);   // → lẻ: đang dùng
+            task_mtx_unlock(t);
+            return t;
+        }
+    }
+}
+
+static void free_task_slot(LinuxTask* t)
+{
+    if (!t) return;
+    task_mtx_lock(t);
+    if (atomic_load_explicit(&t->pub.handle, memory_order_relaxed)) {
+        pub_begin(t);
+        atomic_store_explicit(&t->pub.handle, 0, memory_order_release);
+        pub_end(t);
+        atomic_fetch_sub(&g_task_count, 1u);
+    }
+    atomic_fetch_add(&t->gen, 1u);      // → chẵn: mọi handle cũ hết hiệu lực (seq_cst: cặp với task_notify_pin)
+    task_notify_drain(t);
+    memset((char*)t + TASK_STATE_OFFSET, 0, sizeof(*t) - TASK_STATE_OFFSET);
+    task_mtx_unlock(t);
+    pthread_cond_broadcast(&t->cv);     // Join đang chờ trên slot thấy handle hết hiệu lực
+    push_free_chain(t, t);
+}
+
+// Dọn task đã nhả thread (thr_done); người gọi là bên duy nhất được dọn (deleting / detached)
+static void task_reap(LinuxTask* t)
+{
+    if (t->thr_exit) thread_reap(t->thr);
+    if (t->fib) osal_fiber_destroy(t->fib);
+    release_isolated_cpu(t);
+    free_task_slot(t);
+}
+
+// Create xong: task bắt đầu hiện ra với ForEach / Count / Snapshot
+static OSAL_TaskHandle task_publish(LinuxTask* t, uint32_t flags)
+{
+    OSAL_TaskHandle h = handle_of(t, atomic_load(&t->gen));
+    task_mtx_lock(t);
+    pub_publish_locked(t, h, flags);
+    task_mtx_unlock(t);
+    atomic_fetch_add(&g_task_count, 1u);
+    return h;
+}
+
+// ===== API =====
+
+static OSAL_Status task_create(OSAL_TaskHandle* out, OSAL_TaskEntry entry, void* arg,
+                               const OSAL_TaskAttr* attr, uint8_t gated)
+{
+    if (!out || !entry) return OSAL_EINVAL;
+
+    thread_zombie_reap();
+    LinuxTask* t = alloc_task_slot();
+    if (!t) return OSAL_EINIT;
+
+    t->batch = gated;   // ghi trước khi thread/fiber chạy → đọc không khoá ở cổng
+    t->gated = gated;
+    t->entry = entry;
+    t->arg   = arg;
+    t->suspended = 0;
+    if (attr && (attr->flags & OSAL_TASK_F_PREEMPT_SUSPEND)) {
+        pthread_once(&g_suspend_sig_once, suspend_signal_install);
+        t->preempt = 1;
+    }
+
+    if (attr && attr->name) {
+        strncpy(t->name, attr->name, sizeof(t->name)-1);
+        t->name[sizeof(t->name)-1] = 0;
+    }
+    if (attr) {
+        t->prio_req = attr->prio; // map khi set schedparam
+        t->prio_set = 1;
+    }
+    if (attr && attr->dl_runtime_us) {
+        // runtime <= deadline <= period (deadline = 0 → bằng period)
+        uint32_t dl = attr->dl_deadline_us ? attr->dl_deadline_us : attr->dl_period_us;
+        if (!attr->dl_period_us || attr->dl_runtime_us > dl || dl > attr->dl_period_us ||
+            attr->cpu_mask || (attr->flags & OSAL_TASK_F_ISOLATED_CPU)) {
+            // Kernel yêu cầu task DEADLINE có affinity phủ toàn root domain → không nhận cpu_mask
+            free_task_slot(t);
+            return OSAL_EINVAL;
+        }
+        t->dl_runtime_us  = attr->dl_runtime_us;
+        t->dl_deadline_us = dl;
+        t->dl_period_us   = attr->dl_period_us;
+    }
+    if (attr && (attr->flags & OSAL_TASK_F_FIBER)) {
+        OSAL_Status st = fiber_task_create(t, attr);
+        if (st != OSAL_OK) {
+            free_task_slot(t);
+            return st;
+        }
+        *out = task_publish(t, attr->flags);
+        return OSAL_OK;
+    }
+
+    // Affinity: đặt trước khi thread chạy code người dùng (attr cho thread mới, setaffinity cho thread cache)
+    uint32_t mask = attr ? attr->cpu_mask : 0;
+    if (attr && (attr->flags & OSAL_TASK_F_ISOLATED_CPU)) {
+        int c = pick_isolated_cpu(mask);
+        if (c >= 0) {
+            mask = 1u << c;
+            t->iso_cpu = (uint8_t)(c + 1);
+        } else {
+            OSAL_LOG("[OSAL][Task] %s: no isolated CPU, keep cpu_mask=0x%x\r\n", t->name, (unsigned)mask);
+        }
+    }
+    cpu_set_t set;
+    if (!mask_to_cpuset(mask ? mask : UINT32_MAX, &set)) {
+        release_isolated_cpu(t);
+        free_task_slot(t);
+        return OSAL_EINVAL;
+    }
+    t->cpu_mask = mask;
+    size_t stack_req = attr ? attr->stack_size : 0;
+    if (!stack_req) stack_req = osal_rt_task_stack();   // profile RT: stack prefault thay cho 8 MB bị mlock
+
+    // 1) Tái sử dụng thread rảnh: chỉ cần gắn task + đánh thức
+    LinuxThread* thr = thread_cache_pop(stack_req);
+    if (thr && pthread_setaffinity_np(thr->tid, sizeof(set), &set) != 0) {
+        // Không đặt được affinity cho thread cache → trả nó về, tạo thread mới
+        thread_cache_return(thr);
+        thr = NULL;
+    }
+    if (thr) {
+        t->thr  = thr;
+        t->tid  = thr->tid;
+        t->ktid = thr->ktid;
+        thr->task = t;
+        atomic_store(&thr->wake, 1);
+        futex_wake(&thr->wake, 1);
+    } else {
+        // 2) Tạo thread mới
+        thr = (LinuxThread*)calloc(1, sizeof(*thr));
+        if (!thr) {
+            release_isolated_cpu(t);
+            free_task_slot(t);
+            return OSAL_EINIT;
+        }
+        pthread_attr_t a;
+        pthread_attr_init(&a);
+        if (mask) pthread_attr_setaffinity_np(&a, sizeof(set), &set);
+
+        // Stack size nếu có: lấy từ stack provider (đã prefault, có guard) → không page fault trong vòng RT
+        if (stack_req) {
+            int err = osal_stack_alloc(stack_req, &thr->stack);
+            if (err == 0) {
+                pthread_attr_setstack(&a, thr->stack.base, thr->stack.size);
+            } else {
+                OSAL_LOG("[OSAL][Task] %s: stack provider failed (errno=%d), use pthread stack\r\n", t->name, err);
+                thr->stack_req = osal_stack_round(stack_req);
+                pthread_attr_setstacksize(&a, thr->stack_req);
+            }
+        }
+
+        // Detached? => Không. Thread thoát (không về cache) sẽ được join khi dọn task.
+        pthread_attr_setdetachstate(&a, PTHREAD_CREATE_JOINABLE);
+
+        t->thr    = thr;
+        thr->task = t;
+        pthread_t tid;
+        int rc = pthread_create(&tid, &a, thread_main, thr);
+        pthread_attr_destroy(&a);
+        if (rc != 0) {
+            OSAL_LOG("[OSAL][Task] pthread_create failed rc=%d errno=%d\r\n", rc, errno);
+            release_isolated_cpu(t);
+            osal_stack_free(&thr->stack);
+            free(thr);
+            free_task_slot(t);
+            return OSAL_EINIT;
+        }
+        // thr->tid do chính thread ghi; t->tid cần có ngay cho ChangePrio/SetAffinity
+        task_mtx_lock(t);
+        t->tid = tid;
+        task_mtx_unlock(t);
+    }
+
+    if (t->dl_runtime_us) {
+        // Chờ trampoline áp dụng SCHED_DEADLINE; admission thất bại → task không chạy entry
+        task_mtx_lock(t);
+        while (!t->start_done) {
+            pthread_cond_wait(&t->cv, &t->mtx);
+        }
+        int err = t->start_err;
+        task_mtx_unlock(t);
+        if (err) {
+            // Thread đã nhả task và thoát
+            task_mtx_lock(t);
+            while (!t->thr_done) {
+                pthread_cond_wait(&t->cv, &t->mtx);
+            }
+            task_mtx_unlock(t);
+            thread_reap(thr);
+            free_task_slot(t);
+            return (err == EBUSY) ? OSAL_EBUSY : (err == EINVAL) ? OSAL_EINVAL : OSAL_EOS;
+        }
+    }
+
+    *out = task_publish(t, attr ? attr->flags : 0u);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_TaskCreate(OSAL_TaskHandle* out, OSAL_TaskEntry entry, void* arg, const OSAL_TaskAttr* attr)
+{
+    return task_create(out, entry, arg, attr, 0);
+}
+
+// ===== Batch create =====
+
+typedef struct {
+    const OSAL_TaskSpec* spec;
+    OSAL_TaskHandle*     h;
+    OSAL_Status*         st;
+    uint32_t             n;
+    _Atomic uint32_t     next;
+} TaskBatch;
+
+// Mỗi thread tạo lấy index kế tiếp → các pthread_create / cấp stack chạy song song
+static void* batch_create_worker(void* arg)
+{
+    TaskBatch* b = (TaskBatch*)arg;
+    for (;;) {
+        uint32_t i = atomic_fetch_add(&b->next, 1u);
+        if (i >= b->n) break;
+        b->st[i] = task_create(&b->h[i], b->spec[i].entry, b->spec[i].arg, b->spec[i].attr, 1);
+    }
+    return NULL;
+}
+
+// Task đứng ở cổng trước entry (gated), Delete vẫn dừng được; sau khi thả ngủ đến gate_ns
+static void task_gate_wait(LinuxTask* t)
+{
+    if (!t->batch) return;
+    task_mtx_lock(t);
+    while (t->running && t->gated) {
+        if (t->fib) task_fiber_park_locked(t);
+        else        pthread_cond_wait(&t->cv, &t->mtx);
+    }
+    uint64_t at = t->gate_ns;
+    task_mtx_unlock(t);
+
+    if (at) {
+        struct timespec ts = { (time_t)(at / 1000000000ull), (long)(at % 1000000000ull) };
+        task_sleep_until(&ts);
+    } else {
+        task_checkpoint(t);
+    }
+}
+
+OSAL_Status OSAL_TaskCreateBatch(const OSAL_TaskSpec* spec, uint32_t n, uint32_t align_ms, OSAL_Tick* start)
+{
+    if (!spec || !n) return OSAL_EINVAL;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (!spec[i].entry) return OSAL_EINVAL;
+    }
+
+    TaskBatch b;
+    b.spec = spec;
+    b.n    = n;
+    atomic_init(&b.next, 0u);
+    b.h  = (OSAL_TaskHandle*)calloc(n, sizeof(*b.h));
+    b.st = (OSAL_Status*)calloc(n, sizeof(*b.st));
+    if (!b.h || !b.st) {
+        free(b.h);
+        free(b.st);
+        return OSAL_ENOMEM;
+    }
+
+    // Thread phụ chỉ đáng công khi batch lớn; người gọi cũng tham gia tạo
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t helpers = n / OSAL_TASK_BATCH_PER_HELPER;
+    if (helpers > OSAL_TASK_BATCH_HELPERS) helpers = OSAL_TASK_BATCH_HELPERS;
+    if (cpus > 0 && helpers > (uint32_t)cpus - 1u) helpers = (uint32_t)cpus - 1u;
+    pthread_t hs[OSAL_TASK_BATCH_HELPERS];
+    uint32_t started = 0;
+    for (; started < helpers; ++started) {
+        if (pthread_create(&hs[started], NULL, batch_create_worker, &b) != 0) break;
+    }
+    batch_create_worker(&b);
+    for (uint32_t i = 0; i < started; ++i) pthread_join(hs[i], NULL);
+
+    OSAL_Status st = OSAL_OK;
+    for (uint32_t i = 0; i < n && st == OSAL_OK; ++i) st = b.st[i];
+    if (st != OSAL_OK) {
+        // Task đã tạo chưa chạy entry: Delete dừng chúng ngay tại cổng
+        for (uint32_t i = 0; i < n; ++i) {
+            if (b.st[i] == OSAL_OK) OSAL_TaskDelete(b.h[i]);
+        }
+        free(b.h);
+        free(b.st);
+        return st;
+    }
+
+    // Mốc thả: bội số kế tiếp của align_ms trên lưới tick (0 → thả ngay)
+    uint64_t now = mono_ns();
+    uint64_t at  = 0;
+    if (align_ms) {
+        uint64_t period = (uint64_t)align_ms * 1000000ull;
+        uint64_t now_ms = now / 1000000ull;
+        at = (now_ms - now_ms % align_ms) * 1000000ull + period;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        if (spec[i].handle) *spec[i].handle = b.h[i];
+        LinuxTask* t = task_lock(b.h[i]);
+        if (!t) continue;
+        t->gate_ns = at;
+        t->gated   = 0;
+        task_wake_locked(t);
+        task_mtx_unlock(t);
+    }
+    if (start) *start = (OSAL_Tick)((at ? at : now) / 1000000ull);
+
+    free(b.h);
+    free(b.st);
+    return OSAL_OK;
+}
+
+// Cooperative suspend: đặt cờ và để task “đỗ” trong OSAL_TaskDelayMs / Yield
+// Preemptive (OSAL_TASK_F_PREEMPT_SUSPEND): thêm signal để đỗ ngay cả khi task đang tính toán
+OSAL_Status OSAL_TaskSuspend(OSAL_TaskHandle h)
+{
+    LinuxTask* t = task_lock(h);
+    if (!t) return OSAL_EINVAL;
+
+    LinuxTask* self = task_self();
+    int async = t->preempt && t->running && !t->suspended && t != self;
+    t->suspended = 1;
+    if (async) {
+        atomic_store(&t->park_req, 1);
+        pthread_kill(t->tid, OSAL_SUSPEND_SIGNAL);
+    }
+    // Đánh thức task nếu đang Delay để nó "đỗ" ngay, không đợi hết deadline
+    task_wake_locked(t);
+    if (t == self && t->fib) {
+        // Fiber tự suspend: đỗ ngay (với thread, hiệu lực ở Delay/Yield kế tiếp như cũ)
+        task_wait_resumed_locked(t);
+    }
+    task_mtx_unlock(t);
+
+    if (async) {
+        // Chờ xác nhận đã đỗ (có giới hạn) → khi trả về, task không còn chiếm CPU
+        struct timespec now, deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        timespec_add_ms(&deadline, OSAL_SUSPEND_ACK_MS);
+        while (!atomic_load(&t->park_state) && atomic_load(&t->park_req)) {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            struct timespec rel = { deadline.tv_sec - now.tv_sec, deadline.tv_nsec - now.tv_nsec };
+            if (rel.tv_nsec < 0) { rel.tv_nsec += 1000000000L; rel.tv_sec -= 1; }
+            if (rel.tv_sec < 0) {
+                OSAL_LOG("[OSAL][Task] %s: suspend not acknowledged in %d ms\r\n", t->name, OSAL_SUSPEND_ACK_MS);
+                break;
+            }
+            futex_wait(&t->park_state, 0, &rel);
+        }
+    }
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_TaskResume(OSAL_TaskHandle h)
+{
+    LinuxTask* t = task_lock(h);
+    if (!t) return OSAL_EINVAL;
+
+    t->suspended = 0;
+    // Thả task đang đỗ trong signal handler (có thể nó đang đỗ ngay trong vùng không khoá)
+    if (atomic_exchange(&t->park_req, 0)) {
+        futex_wake(&t->park_req, INT_MAX);
+    }
+    task_wake_locked(t);
+    task_mtx_unlock(t);
+    return OSAL_OK;
+}
+
+// Cooperative delete/stop: yêu cầu dừng + chờ thread nhả task
+OSAL_Status OSAL_TaskDelete(OSAL_TaskHandle h)
+{
+    LinuxTask* t = task_lock(h);
+    if (!t) return OSAL_EINVAL;
+    if (t->deleting || t->detached) {
+        task_mtx_unlock(t);
+        return OSAL_EINVAL;
+    }
+    if (t == task_self()) {
+        // Tự xoá: không thể chờ chính mình nhả task → detach rồi thoát, task_release tự dọn slot
+        t->detached = 1;
+        task_mtx_unlock(t);
+        OSAL_TaskExit(0);
+        return OSAL_OK;     // không tới
+    }
+
+    // Báo dừng
+    t->deleting = 1;
+    t->running = 0;
+    t->suspended = 0;
+    if (atomic_exchange(&t->park_req, 0)) {
+        futex_wake(&t->park_req, INT_MAX);
+    }
+    task_wake_locked(t);
+    // Luôn đổi khỏi WAITING: task vừa thấy running == 1 nhưng chưa kịp ngủ sẽ bị futex_wait trả EAGAIN
+    if (atomic_exchange(&t->notify_state, NOTIFY_STOP) == NOTIFY_WAITING && !t->fib) {
+        futex_wake(&t->notify_state, 1);   // task đang chờ notify → dừng tại NotifyWait/Take
+    }
+    task_mtx_unlock(t);
+
+    // Chờ thread nhả task: entry trả về (thread về cache) hoặc thoát qua stop (phải join)
+    uint32_t spin = 0;
+    task_mtx_lock(t);
+    while (!t->thr_done) {
+        if (osal_fiber_self()) task_fiber_backoff_locked(t, &spin, 0);
+        else                   pthread_cond_wait(&t->cv, &t->mtx);
+    }
+    task_mtx_unlock(t);
+    task_reap(t);
+    return OSAL_OK;
+}
+
+// Chờ task tự kết thúc (không yêu cầu dừng) rồi dọn như Delete
+OSAL_Status OSAL_TaskJoin(OSAL_TaskHandle h, uint32_t timeout_ms, int32_t* status)
+{
+    LinuxTask* t = task_lock(h);
+    if (!t) return OSAL_EINVAL;
+    if (t->deleting || t->detached || t == task_self()) {
+        task_mtx_unlock(t);
+        return OSAL_EINVAL;
+    }
+
+    struct timespec deadline;
+    uint64_t dl_ns = 0;
+    if (timeout_ms != OSAL_WAIT_FOREVER) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        timespec_add_ms(&deadline, timeout_ms);
+        dl_ns = (uint64_t)deadline.tv_sec * 1000000000ull + (uint64_t)deadline.tv_nsec;
+    }
+    int rc = 0;
+    uint32_t spin = 0;
+    while (!t->thr_done && rc != ETIMEDOUT) {
+        if (osal_fiber_self()) {
+            if (task_fiber_backoff_locked(t, &spin, dl_ns)) rc = ETIMEDOUT;
+        } else if (timeout_ms == OSAL_WAIT_FOREVER) {
+            pthread_cond_wait(&t->cv, &t->mtx);
+        } else {
+            rc = pthread_cond_timedwait(&t->cv, &t->mtx, &deadline);
+        }
+        if (task_from_handle(h) != t) {
+            // Delete/Detach khác đã dọn slot trong lúc chờ
+            task_mtx_unlock(t);
+            return OSAL_EINVAL;
+        }
+    }
+    if (!t->thr_done || t->deleting || t->detached) {
+        int busy = !t->thr_done;
+        task_mtx_unlock(t);
+        return busy ? OSAL_ETIMEOUT : OSAL_EINVAL;
+    }
+    t->deleting = 1;
+    int32_t st = t->exit_status;
+    task_mtx_unlock(t);
+
+    task_reap(t);
+    if (status) *status = st;
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_TaskDetach(OSAL_TaskHandle h)
+{
+    thread_zombie_reap();
+    LinuxTask* t = task_lock(h);
+    if (!t) return OSAL_EINVAL;
+    if (t->deleting || t->detached) {
+        task_mtx_unlock(t);
+        return OSAL_EINVAL;
+    }
+    if (!t->thr_done) {
+        // Còn chạy: task_release sẽ tự dọn
+        t->detached = 1;
+        task_mtx_unlock(t);
+        return OSAL_OK;
+    }
+    t->deleting = 1;
+    task_mtx_unlock(t);
+    task_reap(t);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_TaskWaitAny(const OSAL_TaskHandle* h, uint32_t n, uint32_t timeout_ms, uint32_t* index)
+{
+    if (!h || !n) return OSAL_EINVAL;
+
+    struct timespec deadline;
+    uint64_t dl_ns = 0;
+    if (timeout_ms != OSAL_WAIT_FOREVER) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        timespec_add_ms(&deadline, timeout_ms);
+        dl_ns = (uint64_t)deadline.tv_sec * 1000000000ull + (uint64_t)deadline.tv_nsec;
+    }
+
+    OSAL_Status st = OSAL_ETIMEOUT;
+    uint32_t spin = 0;
+    atomic_fetch_add(&g_exit_waiters, 1u);
+    for (;;) {
+        // Đọc seq trước khi quét: task kết thúc sau lần quét sẽ đổi seq → futex không ngủ lỡ
+        int seq = atomic_load(&g_exit_seq);
+        for (uint32_t i = 0; i < n && st == OSAL_ETIMEOUT; ++i) {
+            LinuxTask* t = task_lock(h[i]);
+            if (!t) {
+                st = OSAL_EINVAL;
+            } else {
+                if (t->thr_done) st = OSAL_OK;
+                task_mtx_unlock(t);
+            }
+            if (st != OSAL_ETIMEOUT && index) *index = i;
+        }
+        if (st != OSAL_ETIMEOUT || timeout_ms == 0) break;
+        if (osal_fiber_self()) {
+            // Fiber: task được chờ có thể cùng carrier → không ngủ futex trên carrier
+            if (osal_fiber_backoff(&spin, dl_ns)) timeout_ms = 0;
+        } else if (futex_wait_abs(&g_exit_seq, seq, (timeout_ms == OSAL_WAIT_FOREVER) ? NULL : &deadline) != 0 &&
+            errno == ETIMEDOUT) {
+            timeout_ms = 0;     // quét lần cuối rồi thoát
+        }
+    }
+    atomic_fetch_sub(&g_exit_waiters, 1u);
+    return st;
+}
+
+// Đổi priority runtime
+OSAL_Status OSAL_TaskChangePrio(OSAL_TaskHandle h, uint8_t new_prio)
+{
+    LinuxTask* t = task_lock(h);
+    if (!t) return OSAL_EINVAL;
+    if (t->dl_runtime_us || t->thr_done || t->thr_leaving) {
+        // Task DEADLINE không có priority tĩnh; task đã xong không còn thread
+        task_mtx_unlock(t);
+        return OSAL_EINVAL;
+    }
+
+    int rc = 0;
+    if (t->fib) osal_fiber_set_rank(t->fib, osal_prio_rank(new_prio));   // chỉ đổi thứ tự trên carrier
+    else        rc = set_thread_rt_priority(t, new_prio);
+    if (!t->fib && t->thr) t->thr->sched_dirty = 1;     // kể cả khi thất bại một phần
+    if (rc >= 0) {
+        t->prio_req = new_prio;
+        t->prio_set = 1;
+        pub_update_locked(t);
+    }
+    task_mtx_unlock(t);
+    return (rc >= 0) ? OSAL_OK : OSAL_EINIT;
+}
+
+// Đổi affinity runtime (mask = 0 → mọi CPU)
+OSAL_Status OSAL_TaskSetAffinity(OSAL_TaskHandle h, uint32_t cpu_mask)
+{
+    cpu_set_t set;
+    if (!mask_to_cpuset(cpu_mask ? cpu_mask : UINT32_MAX, &set)) return OSAL_EINVAL;
+
+    LinuxTask* t = task_lock(h);
+    if (!t) return OSAL_EINVAL;
+    if (t->thr_done || t->fib) {
+        // Fiber chạy theo affinity của carrier
+        task_mtx_unlock(t);
+        return OSAL_EINVAL;
+    }
+
+    int rc = pthread_setaffinity_np(t->tid, sizeof(set), &set);
+    if (rc == 0) {
+        // Đã đặt tay → không còn tính vào tải của core isolated tự chọn
+        release_isolated_cpu(t);
+        t->cpu_mask = cpu_mask;
+        pub_update_locked(t);
+    } else {
+        OSAL_LOG("[OSAL][Task] set affinity failed (rc=%d)\r\n", rc);
+    }
+    task_mtx_unlock(t);
+    return (rc == 0) ? OSAL_OK : OSAL_EOS;
+}
+
+OSAL_Status OSAL_TaskGetState(OSAL_TaskHandle h, OSAL_TaskState* state)
+{
+    if (!state) return OSAL_EINVAL;
+    LinuxTask* t = task_lock(h);
+    if (!t) return OSAL_EINVAL;
+
+    if (t->thr_done && !t->deleting) {
+        *state = OSAL_TASK_STATE_COMPLETED;    // đã kết thúc, chờ Join/Delete
+    } else if (!t->running) {
+        *state = OSAL_TASK_STATE_INVALID;
+    } else if (atomic_load(&t->park_state)) {
+        // Chỉ báo SUSPENDED khi task thực sự đã đỗ (suspend đang chờ hiệu lực → vẫn RUNNING/WAITING)
+        *state = OSAL_TASK_STATE_SUSPENDED;
+    } else if (t->blocked == TASK_BLK_DELAY || t->blocked == TASK_BLK_NOTIFY) {
+        *state = OSAL_TASK_STATE_WAITING;
+    } else {
+        *state = OSAL_TASK_STATE_RUNNING;
+    }
+    task_mtx_unlock(t);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_TaskGetName(OSAL_TaskHandle h, const char** name)
+{
+    LinuxTask* t = task_from_handle(h);
+    if (!t || !name) return OSAL_EINVAL;
+    *name = t->name[0] ? t->name : NULL;
+    return OSAL_OK;
+}
+
+// ===== Scheduling helpers (cooperative suspend/stop hook) =====
+
+// Điểm kiểm tra suspend/stop của task hiện tại: đang suspend → chờ Resume, bị Delete → thoát
+static void task_checkpoint(LinuxTask* t)
+{
+    task_mtx_lock(t);
+    if (t->running && t->suspended) {
+        task_wait_resumed_locked(t);
+    }
+    int still_running = t->running;
+    task_mtx_unlock(t);
+
+    if (!still_running) {
+        // Thoát trơn tru: fiber rời carrier, thread chạy cleanup → set running=0
+        if (t->fib) osal_fiber_exit();
+        pthread_exit(NULL);
+    }
+}
+
+void OSAL_TaskExit(int32_t status)
+{
+    LinuxTask* t = task_self();
+    if (!t) return;
+    task_mtx_lock(t);
+    t->exit_status = status;
+    task_mtx_unlock(t);
+    if (t->fib) osal_fiber_exit();
+    pthread_exit(NULL);     // cleanup nhả task như bị stop
+}
+
+void OSAL_TaskYield(void)
+{
+    // Nếu task đang bị suspend → chờ đến khi resume
+    LinuxTask* t = task_self();
+    if (t) {
+        task_checkpoint(t);
+        if (t->fib) {
+            osal_fiber_yield();
+            return;
+        }
+    }
+    sched_yield();
+}
+
+// Ngủ đến deadline tuyệt đối (CLOCK_MONOTONIC) – dùng chung cho DelayMs / DelayUntil
+static void task_sleep_until(const struct timespec* deadline)
+{
+    LinuxTask* t = task_self();
+    if (!t) {
+        // Thread ngoài OSAL (vd: main) → chỉ cần ngủ đến deadline
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL) == EINTR) { }
+        return;
+    }
+
+    int expired = 0;
+    task_mtx_lock(t);
+    t->blocked = TASK_BLK_DELAY;
+    t->delay_count++;
+    while (t->running) {
+        if (t->suspended) {
+            // Đang suspend → chờ Resume/Delete (thời gian delay vẫn tiếp tục trôi)
+            task_wait_resumed_locked(t);
+            continue;
+        }
+        if (expired) break;
+        if (t->fib) {
+            // Fiber: ngủ trên timer heap của carrier, Suspend/Resume/Delete đánh thức qua osal_fiber_wake
+            uint64_t dl_ns = (uint64_t)deadline->tv_sec * 1000000000ull + (uint64_t)deadline->tv_nsec;
+            task_mtx_unlock(t);
+            expired = osal_fiber_sleep_until(dl_ns);
+            task_mtx_lock(t);
+        } else if (pthread_cond_timedwait(&t->cv, &t->mtx, deadline) == ETIMEDOUT) {
+            expired = 1;
+        }
+    }
+    t->blocked = TASK_BLK_NONE;
+    int still_running = t->running;
+    task_mtx_unlock(t);
+
+    if (!still_running) {
+        if (t->fib) osal_fiber_exit();
+        pthread_exit(NULL);
+    }
+}
+
+void OSAL_TaskDelayMs(uint32_t ms)
+{
+    if (ms == 0) {
+        OSAL_TaskYield();
+        return;
+    }
+
+    // Deadline tuyệt đối: không trôi dù bị đánh thức giữa chừng bởi Suspend/Resume
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    timespec_add_ms(&deadline, ms);
+    task_sleep_until(&deadline);
+}
+
+OSAL_Tick OSAL_TaskGetTickCount(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (OSAL_Tick)((uint64_t)now.tv_sec * 1000u + (uint64_t)now.tv_nsec / 1000000u);
+}
+
+OSAL_Status OSAL_TaskDelayUntil(OSAL_Tick* last_wake, uint32_t period_ms)
+{
+    if (!last_wake || period_ms == 0) return OSAL_EINVAL;
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    OSAL_Tick now_tick = (OSAL_Tick)((uint64_t)now.tv_sec * 1000u + (uint64_t)now.tv_nsec / 1000000u);
+
+    // Deadline tính trên lưới tick (ms) → so sánh kiểu int32 để chịu được wrap-around
+    OSAL_Tick next = *last_wake + period_ms;
+    int32_t   ahead_ms = (int32_t)(next - now_tick);
+
+    struct timespec deadline = now;
+    deadline.tv_nsec -= deadline.tv_nsec % 1000000L;   // làm tròn về tick hiện tại
+
+    LinuxTask* t = task_self();
+    if (ahead_ms > 0) {
+        timespec_add_ms(&deadline, (uint32_t)ahead_ms);
+        if (t) {
+            task_mtx_lock(t);
+            t->period_count++;
+            task_mtx_unlock(t);
+        }
+        *last_wake = next;
+        task_sleep_until(&deadline);
+        return OSAL_OK;
+    }
+
+    // Trễ deadline: bỏ qua các chu kỳ đã lỡ để giữ pha, không chạy dồn
+    uint32_t late_ms = (uint32_t)(-ahead_ms);
+    uint32_t skipped = late_ms / period_ms;
+    *last_wake = next + skipped * period_ms;
+
+    if (t) {
+        uint64_t late_us = (uint64_t)late_ms * 1000u + (uint64_t)(now.tv_nsec % 1000000L) / 1000u;
+        task_mtx_lock(t);
+        t->period_count  += 1u + skipped;
+        t->period_missed += 1u + skipped;
+        if (late_us > t->period_worst_us) {
+            t->period_worst_us = (late_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)late_us;
+        }
+        task_mtx_unlock(t);
+    }
+
+    // Vẫn là điểm kiểm tra suspend/stop như Delay
+    OSAL_TaskYield();
+    return OSAL_ETIMEOUT;
+}
+
+OSAL_Status OSAL_TaskGetPeriodStats(OSAL_TaskHandle h, OSAL_TaskPeriodStats* st)
+{
+    if (!st) return OSAL_EINVAL;
+    LinuxTask* t = task_lock(h);
+    if (!t) return OSAL_EINVAL;
+
+    st->periods          = t->period_count;
+    st->missed           = t->period_missed;
+    st->worst_overrun_us = t->period_worst_us;
+    task_mtx_unlock(t);
+    return OSAL_OK;
+}
+
+// ===== Task notification =====
+
+// Gửi notify: chỉ atomic + futex_wake → gọi được từ signal handler (với task thread)
+// Ghi giá trị + trạng thái notify (slot đã được giữ bằng task_notify_pin)
+static OSAL_Status notify_post(LinuxTask* t, uint32_t value, OSAL_NotifyAction action)
+{
+    switch (action) {
+    case OSAL_NOTIFY_NONE:
+        break;
+    case OSAL_NOTIFY_SET_BITS:
+        atomic_fetch_or(&t->notify_val, value);
+        break;
+    case OSAL_NOTIFY_INCREMENT:
+        atomic_fetch_add(&t->notify_val, 1u);
+        break;
+    case OSAL_NOTIFY_OVERWRITE:
+        atomic_store(&t->notify_val, value);
+        break;
+    case OSAL_NOTIFY_NO_OVERWRITE:
+        if (atomic_load(&t->notify_state) == NOTIFY_PENDING) return OSAL_EBUSY;
+        atomic_store(&t->notify_val, value);
+        break;
+    default:
+        return OSAL_EINVAL;
+    }
+
+    // Giá trị ghi trước, trạng thái sau → bên chờ thấy PENDING thì chắc chắn thấy giá trị mới
+    if (atomic_exchange(&t->notify_state, NOTIFY_PENDING) == NOTIFY_WAITING) {
+        if (t->fib) osal_fiber_wake(t->fib);
+        else        futex_wake(&t->notify_state, 1);
+    }
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_TaskNotify(OSAL_TaskHandle h, uint32_t value, OSAL_NotifyAction action)
+{
+    LinuxTask* t = task_notify_pin(h);
+    if (!t) return OSAL_EINVAL;
+    OSAL_Status st = notify_post(t, value, action);
+    task_notify_unpin(t);
+    return st;
+}
+
+// Chờ notify đến deadline (NULL = vô hạn); trả về 1 nếu hết hạn. Không khoá trên đường có notify sẵn.
+static int notify_block(LinuxTask* t, const struct timespec* deadline)
+{
+    int expect = NOTIFY_NONE;
+    if (!atomic_compare_exchange_strong(&t->notify_state, &expect, NOTIFY_WAITING)) {
+        return 0;   // đã PENDING
+    }
+
+    // Kiểm tra lại running sau mỗi lần thức: Delete đổi notify_state sang NOTIFY_STOP rồi mới đánh thức
+    int expired = 0;
+    for (;;) {
+        task_mtx_lock(t);
+        t->blocked = TASK_BLK_NOTIFY;
+        int stop = !t->running;
+        task_mtx_unlock(t);
+        if (stop || expired || atomic_load(&t->notify_state) != NOTIFY_WAITING) break;
+
+        if (t->fib) {
+            if (deadline) {
+                uint64_t dl_ns = (uint64_t)deadline->tv_sec * 1000000000ull + (uint64_t)deadline->tv_nsec;
+                expired = osal_fiber_sleep_until(dl_ns);
+            } else {
+                osal_fiber_park();
+            }
+        } else if (futex_wait_abs(&t->notify_state, NOTIFY_WAITING, deadline) != 0 && errno == ETIMEDOUT) {
+            expired = 1;
+        }
+    }
+
+    // Không ai notify → bỏ trạng thái WAITING (notify đến cùng lúc thì giữ PENDING)
+    expect = NOTIFY_WAITING;
+    atomic_compare_exchange_strong(&t->notify_state, &expect, NOTIFY_NONE);
+
+    task_mtx_lock(t);
+    t->blocked = TASK_BLK_NONE;
+    task_mtx_unlock(t);
+    return expired;
+}
+
+static int notify_deadline(uint32_t timeout_ms, struct timespec* deadline)
+{
+    if (timeout_ms == OSAL_WAIT_FOREVER) return 0;
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    timespec_add_ms(deadline, timeout_ms);
+    return 1;
+}
+
+OSAL_Status OSAL_TaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t* value, uint32_t timeout_ms)
+{
+    LinuxTask* t = task_self();
+    if (!t) return OSAL_EINVAL;
+
+    // Như xTaskNotifyWait: chỉ xoá bit lúc vào khi chưa có notify chờ sẵn
+    if (atomic_load(&t->notify_state) != NOTIFY_PENDING) {
+        atomic_fetch_and(&t->notify_val, ~clear_on_entry);
+    }
+
+    struct timespec dl;
+    const struct timespec* deadline = notify_deadline(timeout_ms, &dl) ? &dl : NULL;
+    for (;;) {
+        int expect = NOTIFY_PENDING;
+        if (atomic_compare_exchange_strong(&t->notify_state, &expect, NOTIFY_NONE)) {
+            uint32_t v = atomic_fetch_and(&t->notify_val, ~clear_on_exit);
+            if (value) *value = v;
+            return OSAL_OK;
+        }
+        int expired = (timeout_ms == 0) || notify_block(t, deadline);
+        task_checkpoint(t);
+        if (expired && atomic_load(&t->notify_state) != NOTIFY_PENDING) {
+            if (value) *value = atomic_load(&t->notify_val);
+            return OSAL_ETIMEOUT;
+        }
+    }
+}
+
+OSAL_Status OSAL_TaskNotifyTake(uint8_t clear, uint32_t* value, uint32_t timeout_ms)
+{
+    LinuxTask* t = task_self();
+    if (!t) return OSAL_EINVAL;
+
+    struct timespec dl;
+    const struct timespec* deadline = notify_deadline(timeout_ms, &dl) ? &dl : NULL;
+    for (;;) {
+        // Tiêu thụ trạng thái trước khi đọc giá trị → không bỏ sót notify đến giữa chừng
+        int expect = NOTIFY_PENDING;
+        atomic_compare_exchange_strong(&t->notify_state, &expect, NOTIFY_NONE);
+
+        uint32_t v = atomic_load(&t->notify_val);
+        while (v && !atomic_compare_exchange_weak(&t->notify_val, &v, clear ? 0u : v - 1u)) { }
+        if (v) {
+            if (value) *value = v;
+            return OSAL_OK;
+        }
+        if (timeout_ms == 0 || notify_block(t, deadline)) {
+            task_checkpoint(t);
+            if (atomic_load(&t->notify_val)) continue;
+            if (value) *value = 0;
+            return OSAL_ETIMEOUT;
+        }
+        task_checkpoint(t);
+    }
+}
+
+// ===== Task-local storage =====
+
+// h = NULL → task hiện tại (TLS, không khoá); ngược lại slot đã khoá (nhả bằng task_mtx_unlock)
+static LinuxTask* local_task(OSAL_TaskHandle h, uint32_t slot)
+{
+    if (slot >= OSAL_TASK_LOCAL_SLOTS) return NULL;
+    return h ? task_lock(h) : task_self();
+}
+
+OSAL_Status OSAL_TaskSetLocal(OSAL_TaskHandle h, uint32_t slot, void* value)
+{
+    LinuxTask* t = local_task(h, slot);
+    if (!t) return OSAL_EINVAL;
+    atomic_store_explicit(&t->local[slot], value, memory_order_release);
+    if (h) task_mtx_unlock(t);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_TaskGetLocal(OSAL_TaskHandle h, uint32_t slot, void** value)
+{
+    if (!value) return OSAL_EINVAL;
+    LinuxTask* t = local_task(h, slot);
+    if (!t) return OSAL_EINVAL;
+    *value = atomic_load_explicit(&t->local[slot], memory_order_acquire);
+    if (h) task_mtx_unlock(t);
+    return OSAL_OK;
+}
+
+// ===== Runtime stats (đọc lười: chỉ tốn chi phí khi được hỏi) =====
+
+// Đọc một dòng "key:   value" trong /proc/self/task/<tid>/status
+static uint32_t proc_status_value(FILE* f, const char* key)
+{
+    char line[128];
+    size_t klen = strlen(key);
+    rewind(f);
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, key, klen) == 0 && line[klen] == ':') {
+            return (uint32_t)strtoul(line + klen + 1, NULL, 10);
+        }
+    }
+    return 0;
+}
+
+// Số liệu của thread trừ mốc lúc gắn task (chép ra dưới khoá)
+static void read_proc_stats(pid_t ktid, const TaskStatsBase* base, OSAL_TaskStats* st)
+{
+    char path[64];
+    FILE* f;
+
+    snprintf(path, sizeof(path), "/proc/self/task/%d/status", (int)ktid);
+    if ((f = fopen(path, "r")) != NULL) {
+        st->voluntary_csw   = proc_status_value(f, "voluntary_ctxt_switches") - base->vcsw;
+        st->involuntary_csw = proc_status_value(f, "nonvoluntary_ctxt_switches") - base->ivcsw;
+        fclose(f);
+    }
+
+    // schedstat: <thời gian chạy ns> <thời gian chờ runqueue ns> <số timeslice>
+    snprintf(path, sizeof(path), "/proc/self/task/%d/schedstat", (int)ktid);
+    if ((f = fopen(path, "r")) != NULL) {
+        unsigned long long run_ns = 0, wait_ns = 0;
+        if (fscanf(f, "%llu %llu", &run_ns, &wait_ns) == 2 && wait_ns >= base->runq_ns) {
+            st->runq_wait_us = (wait_ns - base->runq_ns) / 1000u;
+        }
+        fclose(f);
+    }
+
+    // stat: field 39 = CPU chạy gần nhất; comm (field 2) có thể chứa dấu cách → parse sau ')'
+    snprintf(path, sizeof(path), "/proc/self/task/%d/stat", (int)ktid);
+    if ((f = fopen(path, "r")) != NULL) {
+        char buf[512];
+        size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+        buf[n] = 0;
+        char* p = strrchr(buf, ')');
+        for (int field = 2; p && field < 39; ++field) {
+            p = strchr(p + 1, ' ');
+        }
+        if (p) st->last_cpu = (int32_t)strtol(p + 1, NULL, 10);
+        fclose(f);
+    }
+}
+
+OSAL_Status OSAL_TaskGetStats(OSAL_TaskHandle h, OSAL_TaskStats* st)
+{
+    if (!st) return OSAL_EINVAL;
+    LinuxTask* t = task_lock(h);
+    if (!t) return OSAL_EINVAL;
+
+    memset(st, 0, sizeof(*st));
+    st->handle       = h;
+    snprintf(st->name, sizeof(st->name), "%s", t->name);
+    st->delays       = t->delay_count;
+    st->period.periods          = t->period_count;
+    st->period.missed           = t->period_missed;
+    st->period.worst_overrun_us = t->period_worst_us;
+    st->last_cpu     = -1;
+
+    uint64_t susp  = atomic_load(&t->susp_ns);
+    uint64_t since = atomic_load(&t->susp_since_ns);
+    if (since) susp += mono_ns() - since;
+    st->suspended_us = susp / 1000u;
+
+    pid_t     ktid = t->ktid;
+    pthread_t tid  = t->tid;
+    int       live = t->running;
+    clockid_t cid;
+    if (t->fib) {
+        // Fiber: CPU time đo tại điểm chuyển; policy/prio là của carrier; /proc của carrier không tính
+        st->cpu_time_us = osal_fiber_run_ns(t->fib) / 1000u;
+        ktid = 0;
+    } else if (live && pthread_getcpuclockid(tid, &cid) == 0) {
+        struct timespec ts;
+        if (clock_gettime(cid, &ts) == 0) {
+            uint64_t ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+            st->cpu_time_us = (ns > t->stats_base.cpu_ns) ? (ns - t->stats_base.cpu_ns) / 1000u : 0;
+        }
+    }
+    // Policy/prio thực tế kernel đang áp dụng (sau fallback của set_thread_rt_priority)
+    struct sched_param sp;
+    int policy;
+    if (live && pthread_getschedparam(tid, &policy, &sp) == 0) {
+        st->policy     = policy;
+        st->sched_prio = sp.sched_priority;
+        if (policy == SCHED_OTHER && ktid) {
+            errno = 0;
+            int nice_v = getpriority(PRIO_PROCESS, (id_t)ktid);
+            if (errno == 0) st->sched_prio = nice_v;
+        }
+    }
+    TaskStatsBase base = t->stats_base;
+    task_mtx_unlock(t);
+
+    if (live && ktid) read_proc_stats(ktid, &base, st);
+    return OSAL_OK;
+}
+
+typedef struct {
+    OSAL_TaskStats* out;
+    uint32_t        max;
+    uint32_t        n;
+} StatsCollect;
+
+static void collect_stats_cb(OSAL_TaskHandle h, void* arg)
+{
+    StatsCollect* c = (StatsCollect*)arg;
+    if (c->n < c->max && OSAL_TaskGetStats(h, &c->out[c->n]) == OSAL_OK) {
+        c->n++;
+    }
+}
+
+OSAL_Status OSAL_TaskGetStatsAll(OSAL_TaskStats* out, uint32_t max, uint32_t* count)
+{
+    if (!out || !count) return OSAL_EINVAL;
+    StatsCollect c = { out, max, 0 };
+    OSAL_Status s = OSAL_TaskForEach(collect_stats_cb, &c);
+    *count = c.n;
+    return s;
+}
+
+// ===== Optional: thống kê / duyệt =====
+
+uint32_t OSAL_TaskCount(void)
+{
+    return atomic_load(&g_task_count);
+}
+
+// Handle có thể hết hiệu lực ngay sau khi cb nhận → mọi API trên nó trả OSAL_EINVAL, không bao giờ sai task
+OSAL_Status OSAL_TaskForEach(void (*cb)(OSAL_TaskHandle h, void* arg), void* arg)
+{
+    if (!cb) return OSAL_EINVAL;
+    uint32_t n = atomic_load(&g_nchunks) * OSAL_TASK_CHUNK;
+    for (uint32_t i = 0; i < n; ++i) {
+        LinuxTask* t = slot_at(i);
+        uint64_t h = atomic_load_explicit(&t->pub.handle, memory_order_acquire);
+        if (h) cb((OSAL_TaskHandle)h, arg);
+    }
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_TaskSnapshot(OSAL_TaskInfo* out, uint32_t max, uint32_t* count)
+{
+    if ((!out && max) || !count) return OSAL_EINVAL;
+    uint32_t k = 0;
+    uint32_t n = atomic_load(&g_nchunks) * OSAL_TASK_CHUNK;
+    for (uint32_t i = 0; i < n && k < max; ++i) {
+        if (pub_read(slot_at(i), &out[k])) k++;
+    }
+    *count = k;
     return OSAL_OK;
 }
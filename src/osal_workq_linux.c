@@ -0,0 +1,284 @@
+// OSAL work queue cho Linux
+// - N worker là OSAL task (prio/affinity/stack qua OSAL_TaskCreate) chờ trên một condvar chung
+// - Hàng đợi FIFO intrusive (OSAL_Work do người gọi sở hữu) → Submit không malloc
+// - Flush theo số thứ tự: chỉ chờ các job có seq <= seq lúc gọi Flush (không bị job mới kéo dài)
+
+#include "osal_workq.h"
+#include "osal_task.h"
+#include "osal.h"
+#include "osal_linux_priv.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#ifndef OSAL_WORKQ_MAX_WORKERS
+#define OSAL_WORKQ_MAX_WORKERS 64
+#endif
+
+typedef struct {
+    struct OSAL_WorkQueue* q;
+    OSAL_TaskHandle        task;
+    uint64_t               running_seq;   // seq của job đang chạy (0 = rảnh)
+} WorkQueueWorker;
+
+struct OSAL_WorkQueue {
+    pthread_mutex_t  mtx;
+    pthread_cond_t   cv;          // worker chờ job
+    pthread_cond_t   idle_cv;     // Flush chờ job chạy xong, Destroy chờ worker thoát
+    OSAL_Work*       head;
+    OSAL_Work*       tail;
+    uint64_t         seq;         // seq của job Submit gần nhất
+    uint32_t         idle;        // số worker đang chờ job
+    uint32_t         flushers;    // số lời gọi Flush đang chờ
+    uint8_t          stop;
+    uint32_t         exited;      // số worker đã ra khỏi vòng lặp (không còn chạm q sau khi nhả khoá)
+    uint32_t         nworkers;
+    WorkQueueWorker  workers[];
+};
+
+// Queue mà task hiện tại đang làm worker (chặn Flush tự chờ chính mình)
+static __thread struct OSAL_WorkQueue* tls_wq = NULL;
+
+static void workq_worker(void* arg)
+{
+    WorkQueueWorker* wk = (WorkQueueWorker*)arg;
+    struct OSAL_WorkQueue* q = wk->q;
+    tls_wq = q;
+
+    pthread_mutex_lock(&q->mtx);
+    for (;;) {
+        while (!q->head && !q->stop) {
+            q->idle++;
+            pthread_cond_wait(&q->cv, &q->mtx);
+            q->idle--;
+        }
+        if (!q->head) break;    // stop và đã hết job
+
+        OSAL_Work* w = q->head;
+        q->head = w->next;
+        if (!q->head) q->tail = NULL;
+        w->next    = NULL;
+        w->pending = 0;         // từ đây callback được Submit lại / giải phóng w
+        wk->running_seq = w->seq;
+        OSAL_WorkFn fn = w->fn;
+        void* fn_arg   = w->arg;
+        pthread_mutex_unlock(&q->mtx);
+
+        fn(fn_arg);
+
+        pthread_mutex_lock(&q->mtx);
+        wk->running_seq = 0;
+        if (q->flushers) pthread_cond_broadcast(&q->idle_cv);
+    }
+    tls_wq = NULL;
+    q->exited++;
+    pthread_cond_broadcast(&q->idle_cv);
+    pthread_mutex_unlock(&q->mtx);
+}
+
+// Gọi khi đang giữ q->mtx
+static void workq_enqueue_locked(struct OSAL_WorkQueue* q, OSAL_Work* w)
+{
+    w->next    = NULL;
+    w->seq     = ++q->seq;
+    w->pending = 1;
+    if (q->tail) q->tail->next = w;
+    else         q->head = w;
+    q->tail = w;
+}
+
+// Mọi job có seq <= target đã xong? (gọi khi đang giữ q->mtx)
+static int workq_flushed_locked(const struct OSAL_WorkQueue* q, uint64_t target)
+{
+    if (q->head && q->head->seq <= target) return 0;
+    for (uint32_t i = 0; i < q->nworkers; ++i) {
+        uint64_t s = q->workers[i].running_seq;
+        if (s && s <= target) return 0;
+    }
+    return 1;
+}
+
+void OSAL_WorkInit(OSAL_Work* w, OSAL_WorkFn fn, void* arg)
+{
+    if (!w) return;
+    memset(w, 0, sizeof(*w));
+    w->fn  = fn;
+    w->arg = arg;
+}
+
+OSAL_Status OSAL_WorkQueueCreate(OSAL_WorkQueueHandle* out, const OSAL_WorkQueueAttr* attr)
+{
+    if (!out || !attr) return OSAL_EINVAL;
+    uint32_t n = attr->workers ? attr->workers : 1u;
+    if (n > OSAL_WORKQ_MAX_WORKERS) return OSAL_EINVAL;
+
+    struct OSAL_WorkQueue* q = (struct OSAL_WorkQueue*)calloc(1, sizeof(*q) + n * sizeof(q->workers[0]));
+    if (!q) return OSAL_ENOMEM;
+
+    pthread_condattr_t ca;
+    pthread_condattr_init(&ca);
+    pthread_condattr_setclock(&ca, CLOCK_MONOTONIC);
+    pthread_mutex_init(&q->mtx, NULL);
+    pthread_cond_init(&q->cv, NULL);
+    pthread_cond_init(&q->idle_cv, &ca);
+    pthread_condattr_destroy(&ca);
+
+    OSAL_TaskAttr ta;
+    memset(&ta, 0, sizeof(ta));
+    ta.name       = attr->name ? attr->name : "workq";
+    ta.prio       = attr->prio;
+    ta.stack_size = attr->stack_size;
+    ta.cpu_mask   = attr->cpu_mask;
+
+    OSAL_Status st = OSAL_OK;
+    for (uint32_t i = 0; i < n; ++i) {
+        q->workers[i].q = q;
+        st = OSAL_TaskCreate(&q->workers[i].task, workq_worker, &q->workers[i], &ta);
+        if (st != OSAL_OK) break;
+        q->nworkers++;
+    }
+    if (st != OSAL_OK) {
+        OSAL_LOG("[OSAL][WorkQ] %s: create worker %u failed (%d)\r\n", ta.name, (unsigned)q->nworkers, (int)st);
+        OSAL_WorkQueueDestroy(q);
+        return st;
+    }
+
+    *out = q;
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_WorkQueueDestroy(OSAL_WorkQueueHandle q)
+{
+    if (!q || tls_wq == q) return OSAL_EINVAL;
+
+    // Worker chạy hết job rồi thoát vòng lặp. Phải chờ đủ trước khi Delete: Delete dừng task ngay tại
+    // Delay/NotifyWait kế tiếp, sẽ cắt ngang callback đang ngủ giữa chừng
+    pthread_mutex_lock(&q->mtx);
+    q->stop = 1;
+    pthread_cond_broadcast(&q->cv);
+    while (q->exited < q->nworkers) {
+        pthread_cond_wait(&q->idle_cv, &q->mtx);
+    }
+    pthread_mutex_unlock(&q->mtx);
+
+    for (uint32_t i = 0; i < q->nworkers; ++i) {
+        OSAL_TaskDelete(q->workers[i].task);
+    }
+
+    pthread_cond_destroy(&q->idle_cv);
+    pthread_cond_destroy(&q->cv);
+    pthread_mutex_destroy(&q->mtx);
+    free(q);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_WorkSubmit(OSAL_WorkQueueHandle q, OSAL_Work* w)
+{
+    if (!q || !w || !w->fn) return OSAL_EINVAL;
+
+    pthread_mutex_lock(&q->mtx);
+    if (q->stop) {
+        pthread_mutex_unlock(&q->mtx);
+        return OSAL_EINVAL;
+    }
+    if (w->pending) {
+        pthread_mutex_unlock(&q->mtx);
+        return OSAL_EBUSY;
+    }
+    workq_enqueue_locked(q, w);
+    if (q->idle) pthread_cond_signal(&q->cv);
+    pthread_mutex_unlock(&q->mtx);
+    return OSAL_OK;
+}
+
+OSAL_Status OSAL_WorkSubmitBatch(OSAL_WorkQueueHandle q, OSAL_Work* const* w, uint32_t n, uint32_t* submitted)
+{
+    if (submitted) *submitted = 0;
+    if (!q || (!w && n)) return OSAL_EINVAL;
+
+    OSAL_Status st = OSAL_OK;
+    uint32_t added = 0;
+
+    pthread_mutex_lock(&q->mtx);
+    if (q->stop) {
+        pthread_mutex_unlock(&q->mtx);
+        return OSAL_EINVAL;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        if (!w[i] || !w[i]->fn) {
+            st = OSAL_EINVAL;
+            continue;
+        }
+        if (w[i]->pending) {
+            if (st == OSAL_OK) st = OSAL_EBUSY;
+            continue;
+        }
+        workq_enqueue_locked(q, w[i]);
+        added++;
+    }
+    // Chỉ đánh thức số worker cần thiết
+    if (added >= q->idle) {
+        if (q->idle) pthread_cond_broadcast(&q->cv);
+    } else {
+        for (uint32_t i = 0; i < added; ++i) pthread_cond_signal(&q->cv);
+    }
+    pthread_mutex_unlock(&q->mtx);
+
+    if (submitted) *submitted = added;
+    return st;
+}
+
+OSAL_Status OSAL_WorkCancel(OSAL_WorkQueueHandle q, OSAL_Work* w)
+{
+    if (!q || !w) return OSAL_EINVAL;
+
+    OSAL_Status st = OSAL_EINVAL;
+    pthread_mutex_lock(&q->mtx);
+    if (w->pending) {
+        OSAL_Work* prev = NULL;
+        for (OSAL_Work* it = q->head; it; prev = it, it = it->next) {
+            if (it != w) continue;
+            if (prev) prev->next = w->next;
+            else      q->head    = w->next;
+            if (q->tail == w) q->tail = prev;
+            w->next    = NULL;
+            w->pending = 0;
+            st = OSAL_OK;
+            break;
+        }
+        // Job bị gỡ có thể là thứ duy nhất Flush đang chờ
+        if (st == OSAL_OK && q->flushers) pthread_cond_broadcast(&q->idle_cv);
+    }
+    pthread_mutex_unlock(&q->mtx);
+    return st;
+}
+
+OSAL_Status OSAL_WorkFlush(OSAL_WorkQueueHandle q, uint32_t timeout_ms)
+{
+    if (!q || tls_wq == q) return OSAL_EINVAL;
+
+    struct timespec deadline;
+    if (timeout_ms != OSAL_WAIT_FOREVER) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        timespec_add_ms(&deadline, timeout_ms);
+    }
+
+    OSAL_Status st = OSAL_OK;
+    pthread_mutex_lock(&q->mtx);
+    uint64_t target = q->seq;
+    q->flushers++;
+    while (!workq_flushed_locked(q, target)) {
+        if (timeout_ms == OSAL_WAIT_FOREVER) {
+            pthread_cond_wait(&q->idle_cv, &q->mtx);
+        } else if (pthread_cond_timedwait(&q->idle_cv, &q->mtx, &deadline) == ETIMEDOUT) {
+            if (!workq_flushed_locked(q, target)) st = OSAL_ETIMEOUT;
+            break;
+        }
+    }
+    q->flushers--;
+    pthread_mutex_unlock(&q->mtx);
+    return st;
+}
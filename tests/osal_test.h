@@ -0,0 +1,38 @@
+// Tiện ích chung cho chương trình kiểm thử trong tests/
+// - Mỗi file .c là một chương trình độc lập: exit 0 = PASS (hoặc SKIP khi môi trường thiếu quyền), khác 0 = FAIL
+// - TEST_CHECK không dừng chương trình: ghi lỗi rồi chạy tiếp, test_done tổng kết
+#pragma once
+
+#include <stdio.h>
+#include <time.h>
+
+static int test_failures;
+
+#define TEST_CHECK(cond)                                                        \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            test_failures++;                                                    \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);            \
+        }                                                                       \
+    } while (0)
+
+static inline double test_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+// Chiếm CPU (không ngủ) trong d ms
+static inline void test_busy_ms(double d)
+{
+    double end = test_ms() + d;
+    while (test_ms() < end) {
+    }
+}
+
+static inline int test_done(const char* name)
+{
+    printf("%s %s\n", test_failures ? "FAIL" : "PASS", name);
+    return test_failures != 0;
+}
@@ -0,0 +1,101 @@
+// OSAL_Executor: ParallelFor / ParallelReduce khớp kết quả tuần tự; gọi lồng từ callback
+// - Lồng từ ParallelFor: worker tham gia chạy root con rồi chờ (có giới hạn) phần bị steal
+// - Lồng từ callback reduce: bị từ chối (OSAL_EINVAL) vì có thể reduce vào đúng acc đang dùng dở
+
+#include "osal.h"
+#include "osal_exec.h"
+#include "osal_test.h"
+
+#include <stdlib.h>
+
+#define N 2000000u
+
+static OSAL_ExecHandle g_ex;
+static uint32_t*       g_a;
+
+static void fill(uint32_t b, uint32_t e, void* arg)
+{
+    (void)arg;
+    for (uint32_t i = b; i < e; ++i) g_a[i] = i * 2654435761u;
+}
+
+static void sum_range(uint32_t b, uint32_t e, void* acc, void* arg)
+{
+    (void)arg;
+    uint64_t s = 0;
+    for (uint32_t i = b; i < e; ++i) s += g_a[i];
+    *(uint64_t*)acc += s;
+}
+
+static void count_range(uint32_t b, uint32_t e, void* acc, void* arg)
+{
+    (void)arg;
+    *(uint64_t*)acc += (uint64_t)(e - b);
+}
+
+static void add_u64(void* acc, const void* partial, void* arg)
+{
+    (void)arg;
+    *(uint64_t*)acc += *(const uint64_t*)partial;
+}
+
+static void nested_in_reduce(uint32_t b, uint32_t e, void* acc, void* arg)
+{
+    (void)arg;
+    for (uint32_t i = b; i < e; ++i) {
+        uint64_t zero = 0, r;
+        if (OSAL_ExecParallelReduce(g_ex, 0, 1000, 10, count_range, add_u64, NULL, &zero, &r, sizeof(r)) == OSAL_EINVAL) {
+            *(uint64_t*)acc += 1;
+        }
+    }
+}
+
+static void nested_in_for(uint32_t b, uint32_t e, void* arg)
+{
+    for (uint32_t i = b; i < e; ++i) {
+        uint64_t zero = 0, r = 0;
+        OSAL_ExecParallelReduce(g_ex, 0, 1000, 10, count_range, add_u64, NULL, &zero, &r, sizeof(r));
+        if (r == 1000) __atomic_add_fetch((uint64_t*)arg, 1, __ATOMIC_RELAXED);
+    }
+}
+
+int main(void)
+{
+    OSAL_Config cfg = { .backend = OSAL_BACKEND_LINUX };
+    OSAL_Init(&cfg);
+
+    g_a = malloc(sizeof(uint32_t) * N);
+    OSAL_ExecAttr at = { .name = "ex", .workers = 4 };
+    TEST_CHECK(OSAL_ExecCreate(&g_ex, &at) == OSAL_OK);
+
+    TEST_CHECK(OSAL_ExecParallelFor(g_ex, 0, N, 0, fill, NULL) == OSAL_OK);
+    uint64_t serial = 0;
+    int filled = 1;
+    for (uint32_t i = 0; i < N; ++i) {
+        if (g_a[i] != i * 2654435761u) filled = 0;
+        serial += g_a[i];
+    }
+    TEST_CHECK(filled);
+    uint64_t zero = 0, r = 0;
+    TEST_CHECK(OSAL_ExecParallelReduce(g_ex, 0, N, 0, sum_range, add_u64, NULL, &zero, &r, sizeof(r)) == OSAL_OK);
+    TEST_CHECK(r == serial);
+
+    r = 0;
+    OSAL_ExecParallelReduce(g_ex, 0, 200, 1, nested_in_reduce, add_u64, NULL, &zero, &r, sizeof(r));
+    TEST_CHECK(r == 200);
+
+    uint64_t ok = 0;
+    TEST_CHECK(OSAL_ExecParallelFor(g_ex, 0, 200, 1, nested_in_for, &ok) == OSAL_OK);
+    TEST_CHECK(ok == 200);
+
+    int small_ok = 1;
+    for (int k = 0; k < 1000; ++k) {
+        OSAL_ExecParallelReduce(g_ex, 0, 64, 1, count_range, add_u64, NULL, &zero, &r, sizeof(r));
+        if (r != 64) small_ok = 0;
+    }
+    TEST_CHECK(small_ok);
+
+    TEST_CHECK(OSAL_ExecDestroy(g_ex) == OSAL_OK);
+    free(g_a);
+    return test_done("exec");
+}
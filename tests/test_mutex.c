@@ -0,0 +1,231 @@
+// OSAL_Mutex: đảo ưu tiên (PI), đệ quy, timeout, tranh chấp thread + fiber
+// - Đảo ưu tiên trên 1 CPU: L (thấp) giữ khoá 50 ms, M (giữa) quay 300 ms, H (cao) khoá → có PI thì H chỉ
+//   chờ phần còn lại của L (~50 ms); mutex thường để M chặn L → H chờ ~300 ms
+// - Suspend chủ mutex (PREEMPT_SUSPEND) giữa vùng giữ khoá: task chỉ đỗ sau Unlock, người chờ lấy được khoá
+// - Cần SCHED_FIFO (root / CAP_SYS_NICE); thiếu quyền thì bỏ qua phần đảo ưu tiên và suspend
+
+#include "osal.h"
+#include "osal_task.h"
+#include "osal_mutex.h"
+#include "osal_test.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+static OSAL_MutexHandle g_pi;
+static atomic_int       g_phase;
+static atomic_int       g_rt;
+static double           g_h_wait;
+
+static void task_low(void* arg)
+{
+    (void)arg;
+    atomic_store(&g_rt, sched_getscheduler(0) == SCHED_FIFO);
+    OSAL_MutexLock(g_pi);
+    atomic_store(&g_phase, 1);
+    test_busy_ms(50);
+    OSAL_MutexUnlock(g_pi);
+}
+
+static void task_mid(void* arg)
+{
+    (void)arg;
+    while (atomic_load(&g_phase) < 2) OSAL_TaskDelayMs(1);
+    test_busy_ms(300);
+}
+
+static void task_high(void* arg)
+{
+    (void)arg;
+    while (atomic_load(&g_phase) < 1) OSAL_TaskDelayMs(1);
+    atomic_store(&g_phase, 2);
+    OSAL_TaskDelayMs(2);                  // để M chiếm CPU của L
+    double t0 = test_ms();
+    OSAL_MutexLock(g_pi);
+    g_h_wait = test_ms() - t0;
+    OSAL_MutexUnlock(g_pi);
+}
+
+// Đưa main lên SCHED_FIFO cao nhất (trên 1 CPU task FIFO quay vòng không được chiếm main); 0 nếu thiếu quyền
+static int main_rt_enter(void)
+{
+    struct sched_param sp = { .sched_priority = sched_get_priority_max(SCHED_FIFO) };
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp) == 0;
+}
+
+static void main_rt_exit(void)
+{
+    struct sched_param sp = { .sched_priority = 0 };
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &sp);
+}
+
+static void test_inversion(void)
+{
+    // main cao hơn cả ba: tạo đủ L/M/H trước khi L kịp chạy hết trên CPU chung
+    int main_rt = main_rt_enter();
+
+    OSAL_MutexCreate(&g_pi, NULL);
+    OSAL_TaskAttr al = { .name = "L", .prio = 40, .cpu_mask = 1 };
+    OSAL_TaskAttr am = { .name = "M", .prio = 20, .cpu_mask = 1 };
+    OSAL_TaskAttr ah = { .name = "H", .prio = 5,  .cpu_mask = 1 };
+    OSAL_TaskHandle hl, hm, hh;
+    TEST_CHECK(OSAL_TaskCreate(&hl, task_low, NULL, &al) == OSAL_OK);
+    TEST_CHECK(OSAL_TaskCreate(&hm, task_mid, NULL, &am) == OSAL_OK);
+    TEST_CHECK(OSAL_TaskCreate(&hh, task_high, NULL, &ah) == OSAL_OK);
+    OSAL_TaskJoin(hh, OSAL_WAIT_FOREVER, NULL);
+    OSAL_TaskJoin(hl, OSAL_WAIT_FOREVER, NULL);
+    OSAL_TaskJoin(hm, OSAL_WAIT_FOREVER, NULL);
+    TEST_CHECK(OSAL_MutexDelete(g_pi) == OSAL_OK);
+    main_rt_exit();
+
+    if (!main_rt || !atomic_load(&g_rt)) {
+        printf("  SKIP inversion: không có SCHED_FIFO\n");
+        return;
+    }
+    printf("  inversion: H waited %.1f ms\n", g_h_wait);
+    TEST_CHECK(g_h_wait < 150.0);
+}
+
+static void test_ownership(void)
+{
+    OSAL_MutexHandle m;
+    TEST_CHECK(OSAL_MutexCreate(&m, NULL) == OSAL_OK);
+    TEST_CHECK(OSAL_MutexLock(m) == OSAL_OK);
+    TEST_CHECK(OSAL_MutexLock(m) == OSAL_EINVAL);        // tự khoá lại mutex không đệ quy
+    TEST_CHECK(OSAL_MutexDelete(m) == OSAL_EBUSY);       // đang bị giữ
+    TEST_CHECK(OSAL_MutexUnlock(m) == OSAL_OK);
+    TEST_CHECK(OSAL_MutexUnlock(m) == OSAL_EINVAL);      // không còn là chủ
+    TEST_CHECK(OSAL_MutexDelete(m) == OSAL_OK);
+
+    OSAL_MutexAttr ra = { .name = "rec", .flags = OSAL_MUTEX_F_RECURSIVE };
+    TEST_CHECK(OSAL_MutexCreate(&m, &ra) == OSAL_OK);
+    TEST_CHECK(OSAL_MutexLock(m) == OSAL_OK);
+    TEST_CHECK(OSAL_MutexTryLock(m) == OSAL_OK);
+    TEST_CHECK(OSAL_MutexUnlock(m) == OSAL_OK);
+    TEST_CHECK(OSAL_MutexUnlock(m) == OSAL_OK);
+    TEST_CHECK(OSAL_MutexUnlock(m) == OSAL_EINVAL);
+    TEST_CHECK(OSAL_MutexDelete(m) == OSAL_OK);
+}
+
+static void* hold_200ms(void* arg)
+{
+    OSAL_MutexHandle m = (OSAL_MutexHandle)arg;
+    OSAL_MutexLock(m);
+    struct timespec d = { 0, 200000000 };
+    nanosleep(&d, NULL);
+    OSAL_MutexUnlock(m);
+    return NULL;
+}
+
+static void test_timeout(void)
+{
+    OSAL_MutexHandle m;
+    OSAL_MutexCreate(&m, NULL);
+    pthread_t th;
+    pthread_create(&th, NULL, hold_200ms, m);
+    while (OSAL_MutexTryLock(m) == OSAL_OK) {            // chờ thread kia giữ khoá
+        OSAL_MutexUnlock(m);
+        OSAL_TaskDelayMs(1);
+    }
+    double t0 = test_ms();
+    TEST_CHECK(OSAL_MutexLockTimeout(m, 50) == OSAL_ETIMEOUT);
+    double dt = test_ms() - t0;
+    TEST_CHECK(dt >= 45.0 && dt < 150.0);
+    pthread_join(th, NULL);
+    TEST_CHECK(OSAL_MutexLockTimeout(m, 50) == OSAL_OK);
+    OSAL_MutexUnlock(m);
+    OSAL_MutexDelete(m);
+}
+
+static OSAL_MutexHandle g_held;
+static atomic_int       g_holding, g_holder_stop;
+static atomic_long      g_after_unlock;
+
+// Giữ mutex 50 ms bằng tính toán thuần (không điểm đỗ hợp tác), sau Unlock chỉ đếm
+static void task_holder(void* arg)
+{
+    (void)arg;
+    OSAL_MutexLock(g_held);
+    atomic_store(&g_holding, 1);
+    test_busy_ms(50);
+    OSAL_MutexUnlock(g_held);
+    while (!atomic_load(&g_holder_stop)) atomic_fetch_add(&g_after_unlock, 1);
+}
+
+static void test_suspend_owner(void)
+{
+    if (!main_rt_enter()) {
+        printf("  SKIP suspend owner: không có SCHED_FIFO\n");
+        return;
+    }
+    OSAL_MutexCreate(&g_held, NULL);
+    OSAL_TaskAttr a = { .name = "holder", .prio = 20, .flags = OSAL_TASK_F_PREEMPT_SUSPEND };
+    OSAL_TaskHandle h;
+    OSAL_TaskCreate(&h, task_holder, NULL, &a);
+    while (!atomic_load(&g_holding)) OSAL_TaskDelayMs(1);
+
+    TEST_CHECK(OSAL_TaskSuspend(h) == OSAL_OK);
+    TEST_CHECK(OSAL_MutexLockTimeout(g_held, 1000) == OSAL_OK);   // chủ đỗ sau Unlock, không đỗ cùng khoá
+    OSAL_MutexUnlock(g_held);
+
+    OSAL_TaskDelayMs(20);
+    OSAL_TaskState st;
+    OSAL_TaskGetState(h, &st);
+    TEST_CHECK(st == OSAL_TASK_STATE_SUSPENDED);
+    long a0 = atomic_load(&g_after_unlock);
+    OSAL_TaskDelayMs(20);
+    TEST_CHECK(atomic_load(&g_after_unlock) == a0);
+
+    atomic_store(&g_holder_stop, 1);
+    OSAL_TaskResume(h);
+    OSAL_TaskJoin(h, OSAL_WAIT_FOREVER, NULL);
+    OSAL_MutexDelete(g_held);
+    main_rt_exit();
+}
+
+#define CONTEND_ITERS 20000
+
+static OSAL_MutexHandle g_rec;
+static atomic_int       g_ctr;
+
+// Đọc-sửa-ghi không nguyên tử dưới khoá: mất loại trừ → mất số đếm
+static void task_contend(void* arg)
+{
+    (void)arg;
+    for (int i = 0; i < CONTEND_ITERS; ++i) {
+        OSAL_MutexLock(g_rec);
+        OSAL_MutexLock(g_rec);
+        int v = atomic_load_explicit(&g_ctr, memory_order_relaxed);
+        if (i % 100 == 0) OSAL_TaskYield();
+        atomic_store_explicit(&g_ctr, v + 1, memory_order_relaxed);
+        OSAL_MutexUnlock(g_rec);
+        OSAL_MutexUnlock(g_rec);
+    }
+}
+
+static void test_contention(void)
+{
+    OSAL_MutexAttr ra = { .name = "rec", .flags = OSAL_MUTEX_F_RECURSIVE };
+    OSAL_MutexCreate(&g_rec, &ra);
+    OSAL_TaskAttr fa = { .name = "cf", .flags = OSAL_TASK_F_FIBER };
+    OSAL_TaskAttr ta = { .name = "ct" };
+    OSAL_TaskHandle h[6];
+    for (int i = 0; i < 6; ++i) OSAL_TaskCreate(&h[i], task_contend, NULL, (i < 3) ? &fa : &ta);
+    for (int i = 0; i < 6; ++i) OSAL_TaskJoin(h[i], OSAL_WAIT_FOREVER, NULL);
+    TEST_CHECK(atomic_load(&g_ctr) == 6 * CONTEND_ITERS);
+    OSAL_MutexDelete(g_rec);
+}
+
+int main(void)
+{
+    OSAL_Config cfg = { .backend = OSAL_BACKEND_LINUX };
+    OSAL_Init(&cfg);
+
+    test_inversion();
+    test_suspend_owner();
+    test_ownership();
+    test_timeout();
+    test_contention();
+    return test_done("mutex");
+}
@@ -0,0 +1,111 @@
+// OSAL_Queue: MPMC 4 producer × 4 consumer (thread + fiber), vòng bắt đầu sát 2^32 để đi qua mốc tràn
+// - Biên dịch kèm module queue với OSAL_QUEUE_POS_BASE riêng (libosal.a không kéo bản mặc định vào)
+// - Độ dài 1, 3, 100 (không phải luỹ thừa 2: pos % length) và 64 (mask)
+// - Kiểm tra tổng, thứ tự FIFO theo từng producer, vòng SendToFront, timeout
+
+#define OSAL_QUEUE_POS_BASE (0x100000000ull - 1000u)
+#include "../src/osal_queue_linux.c"
+
+#include "osal_task.h"
+#include "osal_test.h"
+
+#include <stdatomic.h>
+
+#define PRODUCERS   4
+#define CONSUMERS   4
+#define PER_PRODUCER 50000u
+
+typedef struct {
+    uint32_t producer;
+    uint32_t seq;
+} Item;
+
+static OSAL_QueueHandle g_q;
+static atomic_ullong    g_sum;
+static atomic_int       g_bad_order;
+
+static void producer(void* arg)
+{
+    Item it = { (uint32_t)(uintptr_t)arg, 0 };
+    for (uint32_t i = 0; i < PER_PRODUCER; ++i) {
+        it.seq = i;
+        OSAL_QueueSend(g_q, &it, OSAL_WAIT_FOREVER);
+    }
+}
+
+static void consumer(void* arg)
+{
+    (void)arg;
+    int64_t last[PRODUCERS] = { -1, -1, -1, -1 };
+    for (uint32_t i = 0; i < PER_PRODUCER * PRODUCERS / CONSUMERS; ++i) {
+        Item it;
+        OSAL_QueueReceive(g_q, &it, OSAL_WAIT_FOREVER);
+        if (it.producer >= PRODUCERS || (int64_t)it.seq <= last[it.producer]) {
+            atomic_store(&g_bad_order, 1);
+        } else {
+            last[it.producer] = it.seq;
+        }
+        atomic_fetch_add(&g_sum, it.seq);
+    }
+}
+
+static void run_mpmc(uint32_t len)
+{
+    OSAL_QueueAttr qa = { .name = "q", .length = len, .item_size = sizeof(Item), .front_length = 2 };
+    TEST_CHECK(OSAL_QueueCreate(&g_q, &qa) == OSAL_OK);
+    atomic_store(&g_sum, 0);
+    atomic_store(&g_bad_order, 0);
+
+    OSAL_TaskAttr fa = { .name = "qf", .flags = OSAL_TASK_F_FIBER };
+    OSAL_TaskAttr ta = { .name = "qt" };
+    OSAL_TaskHandle h[PRODUCERS + CONSUMERS];
+    double t0 = test_ms();
+    for (int i = 0; i < CONSUMERS; ++i) OSAL_TaskCreate(&h[i], consumer, NULL, (i & 1) ? &fa : &ta);
+    for (int i = 0; i < PRODUCERS; ++i) {
+        OSAL_TaskCreate(&h[CONSUMERS + i], producer, (void*)(uintptr_t)i, (i & 1) ? &fa : &ta);
+    }
+    for (int i = 0; i < PRODUCERS + CONSUMERS; ++i) OSAL_TaskJoin(h[i], OSAL_WAIT_FOREVER, NULL);
+
+    unsigned long long expect = (unsigned long long)PRODUCERS * PER_PRODUCER * (PER_PRODUCER - 1) / 2;
+    printf("  len=%u: %.0f ms\n", len, test_ms() - t0);
+    TEST_CHECK(atomic_load(&g_sum) == expect);
+    TEST_CHECK(!atomic_load(&g_bad_order));
+    TEST_CHECK(atomic_load(&g_q->main.enq) > 0x100000000ull);
+    uint32_t n = 1;
+    OSAL_QueueGetCount(g_q, &n);
+    TEST_CHECK(n == 0);
+    TEST_CHECK(OSAL_QueueDelete(g_q) == OSAL_OK);
+}
+
+static void test_front_and_timeout(void)
+{
+    OSAL_QueueAttr qa = { .name = "f", .length = 4, .item_size = sizeof(Item), .front_length = 2 };
+    OSAL_QueueCreate(&g_q, &qa);
+    Item it = { 0, 1 };
+    OSAL_QueueSend(g_q, &it, 0);
+    it.seq = 2;
+    OSAL_QueueSendToFront(g_q, &it, 0);
+    it.seq = 3;
+    OSAL_QueueSendToFront(g_q, &it, 0);
+    TEST_CHECK(OSAL_QueueTrySendToFront(g_q, &it) == OSAL_EBUSY);
+
+    uint32_t expect[] = { 2, 3, 1 };
+    for (int i = 0; i < 3; ++i) {
+        TEST_CHECK(OSAL_QueueTryReceive(g_q, &it) == OSAL_OK && it.seq == expect[i]);
+    }
+    double t0 = test_ms();
+    TEST_CHECK(OSAL_QueueReceive(g_q, &it, 30) == OSAL_ETIMEOUT);
+    TEST_CHECK(test_ms() - t0 >= 25.0);
+    TEST_CHECK(OSAL_QueueDelete(g_q) == OSAL_OK);
+}
+
+int main(void)
+{
+    OSAL_Config cfg = { .backend = OSAL_BACKEND_LINUX };
+    OSAL_Init(&cfg);
+
+    const uint32_t lens[] = { 1, 3, 64, 100 };
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); ++i) run_mpmc(lens[i]);
+    test_front_and_timeout();
+    return test_done("queue");
+}
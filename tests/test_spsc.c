@@ -0,0 +1,110 @@
+// OSAL_Spsc: 20M item u32 giữa hai task thread theo batch 32 / 64, kiểm tra đúng thứ tự từng item
+// - Thêm cặp fiber (cùng carrier) và kênh ngắn hơn batch (length 5) để đi qua nhánh WaitData / WaitSpace
+// - Timeout, ngưỡng n > length, Delete
+
+#include "osal.h"
+#include "osal_task.h"
+#include "osal_spsc.h"
+#include "osal_test.h"
+
+#define PUSH_BATCH 32u
+#define POP_BATCH  64u
+
+static OSAL_SpscHandle g_ch;
+static uint32_t        g_n;        // số item cần chuyển
+static uint32_t        g_len;
+static uint64_t        g_sum;
+static int             g_bad;
+
+static void producer(void* arg)
+{
+    (void)arg;
+    uint32_t buf[PUSH_BATCH];
+    uint32_t i = 0;
+    while (i < g_n) {
+        uint32_t n = 0;
+        for (; n < PUSH_BATCH && i + n < g_n; ++n) buf[n] = i + n;
+        uint32_t off = 0;
+        while (off < n) {
+            uint32_t k;
+            OSAL_SpscPush(g_ch, buf + off, n - off, &k);
+            off += k;
+            if (off < n) OSAL_SpscWaitSpace(g_ch, 1, OSAL_WAIT_FOREVER);
+        }
+        i += n;
+    }
+}
+
+static void consumer(void* arg)
+{
+    (void)arg;
+    uint32_t buf[POP_BATCH];
+    uint32_t next = 0;
+    while (next < g_n) {
+        uint32_t k;
+        OSAL_SpscPop(g_ch, buf, POP_BATCH, &k);
+        if (!k) {
+            // Chờ cả batch (không quá phần còn lại và sức chứa kênh)
+            uint32_t w = (g_n - next < 16u) ? g_n - next : 16u;
+            if (w > g_len) w = g_len;
+            OSAL_SpscWaitData(g_ch, w, OSAL_WAIT_FOREVER);
+            continue;
+        }
+        for (uint32_t j = 0; j < k; ++j) {
+            if (buf[j] != next) g_bad = 1;
+            g_sum += buf[j];
+            next++;
+        }
+    }
+}
+
+static void run_pair(uint32_t len, uint32_t n, int fiber)
+{
+    OSAL_SpscAttr a = { .name = "ch", .length = len, .item_size = sizeof(uint32_t) };
+    TEST_CHECK(OSAL_SpscCreate(&g_ch, &a) == OSAL_OK);
+    g_n   = n;
+    g_len = len;
+    g_sum = 0;
+    g_bad = 0;
+
+    OSAL_TaskAttr ta = { .name = "spsc", .flags = fiber ? OSAL_TASK_F_FIBER : 0 };
+    OSAL_TaskHandle hp, hc;
+    double t0 = test_ms();
+    OSAL_TaskCreate(&hc, consumer, NULL, &ta);
+    OSAL_TaskCreate(&hp, producer, NULL, &ta);
+    OSAL_TaskJoin(hp, OSAL_WAIT_FOREVER, NULL);
+    OSAL_TaskJoin(hc, OSAL_WAIT_FOREVER, NULL);
+    printf("  len=%u n=%u fiber=%d: %.0f ms\n", len, n, fiber, test_ms() - t0);
+
+    TEST_CHECK(!g_bad);
+    TEST_CHECK(g_sum == (uint64_t)n * (n - 1) / 2);
+    TEST_CHECK(OSAL_SpscDelete(g_ch) == OSAL_OK);
+}
+
+static void test_wait_edges(void)
+{
+    OSAL_SpscAttr a = { .name = "e", .length = 8, .item_size = sizeof(uint32_t) };
+    OSAL_SpscCreate(&g_ch, &a);
+    double t0 = test_ms();
+    TEST_CHECK(OSAL_SpscWaitData(g_ch, 1, 20) == OSAL_ETIMEOUT);
+    TEST_CHECK(test_ms() - t0 >= 15.0);
+    TEST_CHECK(OSAL_SpscWaitData(g_ch, 9, 0) == OSAL_EINVAL);
+    TEST_CHECK(OSAL_SpscWaitSpace(g_ch, 8, 0) == OSAL_OK);
+    uint32_t n = 1;
+    OSAL_SpscGetCount(g_ch, &n);
+    TEST_CHECK(n == 0);
+    TEST_CHECK(OSAL_SpscDelete(g_ch) == OSAL_OK);
+}
+
+int main(void)
+{
+    OSAL_Config cfg = { .backend = OSAL_BACKEND_LINUX };
+    OSAL_Init(&cfg);
+
+    run_pair(1024, 20000000u, 0);
+    run_pair(1024, 2000000u, 1);
+    run_pair(5, 200000u, 0);
+    run_pair(5, 200000u, 1);
+    test_wait_edges();
+    return test_done("spsc");
+}
@@ -0,0 +1,172 @@
+// OSAL task: các đường dễ treo / dễ lạc giữa task và slot
+// - Fiber Delete / Join / WaitAny một fiber khác cùng carrier: không được block carrier (deadlock)
+// - Notify bằng handle cũ trong lúc slot bị dọn và cấp lại: task mới không nhận notify lạc
+// - Snapshot trong lúc Create/Delete liên tục: bản ghi không rách (name khớp prio)
+
+#include "osal.h"
+#include "osal_task.h"
+#include "osal_test.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
+
+// ===== Fiber điều khiển fiber khác trên cùng carrier =====
+
+static atomic_int g_ctl_done;
+static int        g_del, g_join, g_status, g_waitany, g_join_to;
+static uint32_t   g_idx;
+
+static void fiber_spin(void* arg)
+{
+    (void)arg;
+    for (;;) OSAL_TaskDelayMs(1);
+}
+
+static void fiber_short(void* arg)
+{
+    for (long i = 0; i < (long)arg; ++i) OSAL_TaskDelayMs(1);
+    OSAL_TaskExit(7);
+}
+
+static void fiber_ctl(void* arg)
+{
+    (void)arg;
+    OSAL_TaskAttr f = { .name = "s", .flags = OSAL_TASK_F_FIBER, .prio = 20 };
+    OSAL_TaskHandle s, j, w[2];
+    int32_t st = 0;
+
+    OSAL_TaskCreate(&s, fiber_spin, NULL, &f);
+    OSAL_TaskDelayMs(5);
+    g_del = OSAL_TaskDelete(s);
+
+    OSAL_TaskCreate(&j, fiber_short, (void*)5L, &f);
+    g_join   = OSAL_TaskJoin(j, OSAL_WAIT_FOREVER, &st);
+    g_status = st;
+
+    OSAL_TaskCreate(&w[0], fiber_spin, NULL, &f);
+    OSAL_TaskCreate(&w[1], fiber_short, (void*)3L, &f);
+    g_waitany = OSAL_TaskWaitAny(w, 2, 1000, &g_idx);
+    g_join_to = OSAL_TaskJoin(w[0], 10, NULL);
+    OSAL_TaskDelete(w[0]);
+    OSAL_TaskJoin(w[1], 0, NULL);
+    atomic_store(&g_ctl_done, 1);
+}
+
+static void test_fiber_ctl(void)
+{
+    OSAL_TaskAttr f = { .name = "c", .flags = OSAL_TASK_F_FIBER, .prio = 10 };
+    OSAL_TaskHandle c;
+    OSAL_TaskCreate(&c, fiber_ctl, NULL, &f);
+    for (int i = 0; i < 200 && !atomic_load(&g_ctl_done); ++i) usleep(10000);
+    TEST_CHECK(atomic_load(&g_ctl_done));
+    if (!atomic_load(&g_ctl_done)) return;
+    TEST_CHECK(g_del == OSAL_OK);
+    TEST_CHECK(g_join == OSAL_OK && g_status == 7);
+    TEST_CHECK(g_waitany == OSAL_OK && g_idx == 1);
+    TEST_CHECK(g_join_to == OSAL_ETIMEOUT);
+    OSAL_TaskJoin(c, OSAL_WAIT_FOREVER, NULL);
+}
+
+// ===== Notify bằng handle cũ =====
+
+#define NOTIFY_ROUNDS 20000
+
+static _Atomic OSAL_TaskHandle g_stale;
+static atomic_int              g_stop, g_spurious;
+
+static void task_notified(void* arg)
+{
+    (void)arg;
+    uint32_t v;
+    if (OSAL_TaskNotifyWait(0, 0, &v, 0) == OSAL_OK) atomic_fetch_add(&g_spurious, 1);
+}
+
+static void* notifier(void* arg)
+{
+    (void)arg;
+    while (!atomic_load(&g_stop)) OSAL_TaskNotify(atomic_load(&g_stale), 1, OSAL_NOTIFY_SET_BITS);
+    return NULL;
+}
+
+static void test_notify_stale(void)
+{
+    pthread_t th[2];
+    for (int i = 0; i < 2; ++i) pthread_create(&th[i], NULL, notifier, NULL);
+    OSAL_TaskAttr a = { .name = "n", .prio = 100 };
+    for (int i = 0; i < NOTIFY_ROUNDS; ++i) {
+        OSAL_TaskHandle h;
+        OSAL_TaskCreate(&h, task_notified, NULL, &a);
+        OSAL_TaskJoin(h, OSAL_WAIT_FOREVER, NULL);
+        atomic_store(&g_stale, h);
+    }
+    atomic_store(&g_stop, 1);
+    for (int i = 0; i < 2; ++i) pthread_join(th[i], NULL);
+    TEST_CHECK(atomic_load(&g_spurious) == 0);
+}
+
+// ===== Snapshot trong lúc churn =====
+
+static atomic_int g_churn_stop;
+
+static void task_brief(void* arg)
+{
+    (void)arg;
+    OSAL_TaskDelayMs(1);
+}
+
+static void* churn(void* arg)
+{
+    (void)arg;
+    OSAL_TaskAttr a = { .name = "churn", .prio = 3 };
+    for (int i = 0; !atomic_load(&g_churn_stop); ++i) {
+        OSAL_TaskHandle h;
+        a.flags = (i & 1) ? OSAL_TASK_F_FIBER : 0;
+        if (OSAL_TaskCreate(&h, task_brief, NULL, &a) == OSAL_OK) OSAL_TaskDelete(h);
+    }
+    return NULL;
+}
+
+static void test_snapshot(void)
+{
+    OSAL_TaskAttr fa = { .name = "fixed-task-name", .prio = 7 };
+    OSAL_TaskHandle fixed;
+    OSAL_TaskCreate(&fixed, fiber_spin, NULL, &fa);
+    pthread_t th[3];
+    for (int i = 0; i < 3; ++i) pthread_create(&th[i], NULL, churn, NULL);
+
+    OSAL_TaskInfo info[64];
+    long bad = 0, fixed_seen = 0;
+    for (int it = 0; it < 20000; ++it) {
+        uint32_t n = 0;
+        OSAL_TaskSnapshot(info, 64, &n);
+        for (uint32_t i = 0; i < n; ++i) {
+            if (strcmp(info[i].name, "churn") == 0) {
+                if (info[i].prio != 3) bad++;
+            } else if (strcmp(info[i].name, "fixed-task-name") == 0) {
+                if (info[i].prio != 7) bad++;
+                fixed_seen++;
+            } else {
+                bad++;
+            }
+        }
+    }
+    atomic_store(&g_churn_stop, 1);
+    for (int i = 0; i < 3; ++i) pthread_join(th[i], NULL);
+    TEST_CHECK(bad == 0);
+    TEST_CHECK(fixed_seen == 20000);
+    OSAL_TaskDelete(fixed);
+}
+
+int main(void)
+{
+    OSAL_Config cfg = { .backend = OSAL_BACKEND_LINUX };
+    OSAL_Init(&cfg);
+
+    test_fiber_ctl();
+    test_notify_stale();
+    test_snapshot();
+    TEST_CHECK(OSAL_TaskCount() == 0);
+    return test_done("task");
+}
@@ -0,0 +1,72 @@
+// OSAL_WorkQueue: Destroy chờ cả callback đang ngủ (TaskDelay) chạy xong rồi mới dọn worker; Flush / Cancel
+
+#include "osal.h"
+#include "osal_task.h"
+#include "osal_workq.h"
+#include "osal_test.h"
+
+#include <stdatomic.h>
+
+static atomic_int g_started, g_finished;
+
+static void job_sleepy(void* arg)
+{
+    (void)arg;
+    atomic_fetch_add(&g_started, 1);
+    OSAL_TaskDelayMs(30);
+    atomic_fetch_add(&g_finished, 1);
+}
+
+static void job_count(void* arg)
+{
+    atomic_fetch_add((atomic_int*)arg, 1);
+}
+
+static void test_destroy_waits(void)
+{
+    OSAL_WorkQueueAttr qa = { .name = "wq", .workers = 2 };
+    OSAL_WorkQueueHandle q;
+    TEST_CHECK(OSAL_WorkQueueCreate(&q, &qa) == OSAL_OK);
+    static OSAL_Work w[6];
+    for (int i = 0; i < 6; ++i) {
+        OSAL_WorkInit(&w[i], job_sleepy, NULL);
+        OSAL_WorkSubmit(q, &w[i]);
+    }
+    while (!atomic_load(&g_started)) OSAL_TaskDelayMs(1);
+    TEST_CHECK(OSAL_WorkQueueDestroy(q) == OSAL_OK);
+    TEST_CHECK(atomic_load(&g_finished) == 6);
+    TEST_CHECK(OSAL_TaskCount() == 0);
+}
+
+static void test_flush_cancel(void)
+{
+    OSAL_WorkQueueAttr qa = { .name = "wq", .workers = 1 };
+    OSAL_WorkQueueHandle q;
+    OSAL_WorkQueueCreate(&q, &qa);
+
+    // Chặn worker bằng job ngủ để job sau còn nằm trong hàng đợi khi Cancel
+    atomic_int n = 0;
+    static OSAL_Work block, w[4];
+    OSAL_WorkInit(&block, job_sleepy, NULL);
+    OSAL_WorkSubmit(q, &block);
+    for (int i = 0; i < 4; ++i) {
+        OSAL_WorkInit(&w[i], job_count, &n);
+        TEST_CHECK(OSAL_WorkSubmit(q, &w[i]) == OSAL_OK);
+    }
+    TEST_CHECK(OSAL_WorkSubmit(q, &w[0]) == OSAL_EBUSY);
+    TEST_CHECK(OSAL_WorkCancel(q, &w[3]) == OSAL_OK);
+    TEST_CHECK(OSAL_WorkCancel(q, &w[3]) == OSAL_EINVAL);
+    TEST_CHECK(OSAL_WorkFlush(q, 1000) == OSAL_OK);
+    TEST_CHECK(atomic_load(&n) == 3);
+    TEST_CHECK(OSAL_WorkQueueDestroy(q) == OSAL_OK);
+}
+
+int main(void)
+{
+    OSAL_Config cfg = { .backend = OSAL_BACKEND_LINUX };
+    OSAL_Init(&cfg);
+
+    test_destroy_waits();
+    test_flush_cancel();
+    return test_done("workq");
+}